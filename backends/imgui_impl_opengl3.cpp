@@ -6,6 +6,7 @@
 // Implemented features:
 //  [X] Renderer: User texture binding. Use 'GLuint' OpenGL texture identifier as void*/ImTextureID. Read the FAQ about ImTextureID!
 //  [x] Renderer: Large meshes support (64k+ vertices) with 16-bit indices (Desktop OpenGL only).
+//  [X] Renderer: Texture updates. Creates RGBA32 textures and uploads parts of them via io.RendererCreateTextureFn/io.RendererUpdateTextureFn.
 
 // About WebGL/ES:
 // - You need to '#define IMGUI_IMPL_OPENGL_ES2' or '#define IMGUI_IMPL_OPENGL_ES3' to use WebGL or OpenGL ES.
@@ -22,6 +23,7 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2024-09-02: OpenGL: Added support for ImGuiBackendFlags_RendererHasTextureUpdates: io.RendererCreateTextureFn, io.RendererUpdateTextureFn, io.RendererDestroyTextureFn.
 //  2024-06-28: OpenGL: ImGui_ImplOpenGL3_NewFrame() recreates font texture if it has been destroyed by ImGui_ImplOpenGL3_DestroyFontsTexture(). (#7748)
 //  2024-05-07: OpenGL: Update loader for Linux to support EGL/GLVND. (#7562)
 //  2024-04-16: OpenGL: Detect ES3 contexts on desktop based on version string, to e.g. avoid calling glPolygonMode() on them. (#7447)
@@ -249,6 +251,12 @@ static ImGui_ImplOpenGL3_Data* ImGui_ImplOpenGL3_GetBackendData()
     return ImGui::GetCurrentContext() ? (ImGui_ImplOpenGL3_Data*)ImGui::GetIO().BackendRendererUserData : nullptr;
 }
 
+// For the texture hooks, which may be called while another context is current (or none)
+static ImGui_ImplOpenGL3_Data* ImGui_ImplOpenGL3_GetBackendData(ImGuiContext* ctx)
+{
+    return (ImGui_ImplOpenGL3_Data*)ImGui::GetIO(ctx).BackendRendererUserData;
+}
+
 // OpenGL vertex attribute state (for ES 1.0 and ES 2.0 only)
 #ifndef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
 struct ImGui_ImplOpenGL3_VtxAttribState
@@ -273,6 +281,11 @@ struct ImGui_ImplOpenGL3_VtxAttribState
 };
 #endif
 
+// Forward Declarations
+static ImTextureID ImGui_ImplOpenGL3_CreateTexture(ImGuiContext* ctx, int width, int height);
+static void ImGui_ImplOpenGL3_UpdateTexture(ImGuiContext* ctx, ImTextureID tex_id, const ImTextureRect* rects, int rects_count, const void* pixels, int pitch);
+static void ImGui_ImplOpenGL3_DestroyTexture(ImGuiContext* ctx, ImTextureID tex_id);
+
 // Functions
 bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
 {
@@ -341,6 +354,10 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
     if (bd->GlVersion >= 320)
         io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
 #endif
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextureUpdates;     // We can create textures and update parts of them.
+    io.RendererCreateTextureFn = ImGui_ImplOpenGL3_CreateTexture;
+    io.RendererUpdateTextureFn = ImGui_ImplOpenGL3_UpdateTexture;
+    io.RendererDestroyTextureFn = ImGui_ImplOpenGL3_DestroyTexture;
 
     // Store GLSL version string so we can refer to it later in case we recreate shaders.
     // Note: GLSL version is NOT the same as GL version. Leave this to nullptr if unsure.
@@ -393,7 +410,10 @@ void    ImGui_ImplOpenGL3_Shutdown()
     ImGui_ImplOpenGL3_DestroyDeviceObjects();
     io.BackendRendererName = nullptr;
     io.BackendRendererUserData = nullptr;
-    io.BackendFlags &= ~ImGuiBackendFlags_RendererHasVtxOffset;
+    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasTextureUpdates);
+    io.RendererCreateTextureFn = nullptr;
+    io.RendererUpdateTextureFn = nullptr;
+    io.RendererDestroyTextureFn = nullptr;
     IM_DELETE(bd);
 }
 
@@ -707,6 +727,69 @@ void ImGui_ImplOpenGL3_DestroyFontsTexture()
     }
 }
 
+// Textures created through io.RendererCreateTextureFn, e.g. for widgets drawing into a CPU-side surface.
+static ImTextureID ImGui_ImplOpenGL3_CreateTexture(ImGuiContext*, int width, int height)
+{
+    GLint last_texture;
+    GLuint texture = 0;
+    GL_CALL(glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture));
+    GL_CALL(glGenTextures(1, &texture));
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, texture));
+    GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+    GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+    GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, last_texture));
+    return (ImTextureID)(intptr_t)texture;
+}
+
+static void ImGui_ImplOpenGL3_UpdateTexture(ImGuiContext* ctx, ImTextureID tex_id, const ImTextureRect* rects, int rects_count, const void* pixels, int pitch)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData(ctx);
+
+    // Backup GL state
+    GLint last_texture;
+    GL_CALL(glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture));
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_BUFFER_PIXEL_UNPACK
+    GLint last_pixel_unpack_buffer = 0;
+    if (bd->GlVersion >= 210) { glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &last_pixel_unpack_buffer); glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0); }
+#endif
+#ifdef GL_UNPACK_ROW_LENGTH // Not on WebGL/ES
+    GLint last_unpack_row_length;
+    GL_CALL(glGetIntegerv(GL_UNPACK_ROW_LENGTH, &last_unpack_row_length));
+    GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, pitch / 4));
+#endif
+
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)tex_id));
+    for (int n = 0; n < rects_count; n++)
+    {
+        const ImTextureRect& r = rects[n];
+        const unsigned char* src = (const unsigned char*)pixels + (size_t)r.y * pitch + (size_t)r.x * 4;
+#ifdef GL_UNPACK_ROW_LENGTH
+        GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, r.x, r.y, r.w, r.h, GL_RGBA, GL_UNSIGNED_BYTE, src));
+#else
+        // Without GL_UNPACK_ROW_LENGTH, rows narrower than the texture have to be sent one by one
+        for (int y = 0; y < r.h; y++)
+            GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, r.x, r.y + y, r.w, 1, GL_RGBA, GL_UNSIGNED_BYTE, src + (size_t)y * pitch));
+#endif
+    }
+
+    // Restore modified GL state
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, last_texture));
+#ifdef GL_UNPACK_ROW_LENGTH
+    GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, last_unpack_row_length));
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_BUFFER_PIXEL_UNPACK
+    if (bd->GlVersion >= 210) { glBindBuffer(GL_PIXEL_UNPACK_BUFFER, last_pixel_unpack_buffer); }
+#endif
+    (void)bd; // Not all compilation paths use this
+}
+
+static void ImGui_ImplOpenGL3_DestroyTexture(ImGuiContext*, ImTextureID tex_id)
+{
+    GLuint texture = (GLuint)(intptr_t)tex_id;
+    GL_CALL(glDeleteTextures(1, &texture));
+}
+
 // If you get an error please report on github. You may try different GL context version or GLSL version. See GL<>GLSL version table at the top of this file.
 static bool CheckShader(GLuint handle, const char* desc)
 {
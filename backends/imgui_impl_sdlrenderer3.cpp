@@ -10,6 +10,7 @@
 // Implemented features:
 //  [X] Renderer: User texture binding. Use 'SDL_Texture*' as ImTextureID. Read the FAQ about ImTextureID!
 //  [X] Renderer: Large meshes support (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Texture updates. Creates RGBA32 textures and uploads parts of them via io.RendererCreateTextureFn/io.RendererUpdateTextureFn.
 
 // You can copy and use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
 // Prefer including the entire imgui/ repository into your project (either as a copy or as a submodule), and only build the backends you need.
@@ -20,6 +21,7 @@
 // - Introduction, links and more at the top of imgui.cpp
 
 // CHANGELOG
+//  2024-09-02: Added support for ImGuiBackendFlags_RendererHasTextureUpdates: io.RendererCreateTextureFn, io.RendererUpdateTextureFn, io.RendererDestroyTextureFn.
 //  2024-07-01: Update for SDL3 api changes: SDL_RenderGeometryRaw() uint32 version was removed (SDL#9009).
 //  2024-05-14: *BREAKING CHANGE* ImGui_ImplSDLRenderer3_RenderDrawData() requires SDL_Renderer* passed as parameter.
 //  2024-02-12: Amend to query SDL_RenderViewportSet() and restore viewport accordingly.
@@ -59,6 +61,17 @@ static ImGui_ImplSDLRenderer3_Data* ImGui_ImplSDLRenderer3_GetBackendData()
     return ImGui::GetCurrentContext() ? (ImGui_ImplSDLRenderer3_Data*)ImGui::GetIO().BackendRendererUserData : nullptr;
 }
 
+// For the texture hooks, which may be called while another context is current (or none)
+static ImGui_ImplSDLRenderer3_Data* ImGui_ImplSDLRenderer3_GetBackendData(ImGuiContext* ctx)
+{
+    return (ImGui_ImplSDLRenderer3_Data*)ImGui::GetIO(ctx).BackendRendererUserData;
+}
+
+// Forward Declarations
+static ImTextureID ImGui_ImplSDLRenderer3_CreateTexture(ImGuiContext* ctx, int width, int height);
+static void ImGui_ImplSDLRenderer3_UpdateTexture(ImGuiContext* ctx, ImTextureID tex_id, const ImTextureRect* rects, int rects_count, const void* pixels, int pitch);
+static void ImGui_ImplSDLRenderer3_DestroyTexture(ImGuiContext* ctx, ImTextureID tex_id);
+
 // Functions
 bool ImGui_ImplSDLRenderer3_Init(SDL_Renderer* renderer)
 {
@@ -72,6 +85,10 @@ bool ImGui_ImplSDLRenderer3_Init(SDL_Renderer* renderer)
     io.BackendRendererUserData = (void*)bd;
     io.BackendRendererName = "imgui_impl_sdlrenderer3";
     io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextureUpdates; // We can create textures and update parts of them.
+    io.RendererCreateTextureFn = ImGui_ImplSDLRenderer3_CreateTexture;
+    io.RendererUpdateTextureFn = ImGui_ImplSDLRenderer3_UpdateTexture;
+    io.RendererDestroyTextureFn = ImGui_ImplSDLRenderer3_DestroyTexture;
 
     bd->Renderer = renderer;
 
@@ -88,7 +105,10 @@ void ImGui_ImplSDLRenderer3_Shutdown()
 
     io.BackendRendererName = nullptr;
     io.BackendRendererUserData = nullptr;
-    io.BackendFlags &= ~ImGuiBackendFlags_RendererHasVtxOffset;
+    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasTextureUpdates);
+    io.RendererCreateTextureFn = nullptr;
+    io.RendererUpdateTextureFn = nullptr;
+    io.RendererDestroyTextureFn = nullptr;
     IM_DELETE(bd);
 }
 
@@ -221,6 +241,37 @@ void ImGui_ImplSDLRenderer3_RenderDrawData(ImDrawData* draw_data, SDL_Renderer*
     SDL_SetRenderClipRect(renderer, old.ClipEnabled ? &old.ClipRect : nullptr);
 }
 
+// Textures created through io.RendererCreateTextureFn, e.g. for widgets drawing into a CPU-side surface.
+static ImTextureID ImGui_ImplSDLRenderer3_CreateTexture(ImGuiContext* ctx, int width, int height)
+{
+    ImGui_ImplSDLRenderer3_Data* bd = ImGui_ImplSDLRenderer3_GetBackendData(ctx);
+    SDL_Texture* texture = SDL_CreateTexture(bd->Renderer, SDL_PIXELFORMAT_ABGR8888, SDL_TEXTUREACCESS_STATIC, width, height);
+    if (texture == nullptr)
+    {
+        SDL_Log("error creating texture");
+        return 0;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_LINEAR);
+    return (ImTextureID)(intptr_t)texture;
+}
+
+static void ImGui_ImplSDLRenderer3_UpdateTexture(ImGuiContext*, ImTextureID tex_id, const ImTextureRect* rects, int rects_count, const void* pixels, int pitch)
+{
+    SDL_Texture* texture = (SDL_Texture*)(intptr_t)tex_id;
+    for (int n = 0; n < rects_count; n++)
+    {
+        const ImTextureRect& r = rects[n];
+        const SDL_Rect rect = { r.x, r.y, r.w, r.h };
+        SDL_UpdateTexture(texture, &rect, (const unsigned char*)pixels + (size_t)r.y * pitch + (size_t)r.x * 4, pitch);
+    }
+}
+
+static void ImGui_ImplSDLRenderer3_DestroyTexture(ImGuiContext*, ImTextureID tex_id)
+{
+    SDL_DestroyTexture((SDL_Texture*)(intptr_t)tex_id);
+}
+
 // Called by Init/NewFrame/Shutdown
 bool ImGui_ImplSDLRenderer3_CreateFontsTexture()
 {
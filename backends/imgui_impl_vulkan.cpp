@@ -4,6 +4,7 @@
 // Implemented features:
 //  [!] Renderer: User texture binding. Use 'VkDescriptorSet' as ImTextureID. Read the FAQ about ImTextureID! See https://github.com/ocornut/imgui/pull/914 for discussions.
 //  [X] Renderer: Large meshes support (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Texture updates. Creates RGBA32 textures and uploads parts of them via io.RendererCreateTextureFn/io.RendererUpdateTextureFn.
 
 // Important: on 32-bit systems, user texture binding is only supported if your imconfig file has '#define ImTextureID ImU64'.
 // This is because we need ImTextureID to carry a 64-bit value and by default ImTextureID is defined as void*.
@@ -33,6 +34,7 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2024-09-02: Vulkan: Added support for ImGuiBackendFlags_RendererHasTextureUpdates: io.RendererCreateTextureFn, io.RendererUpdateTextureFn, io.RendererDestroyTextureFn. Uploads go through a per-texture staging buffer, command buffer and fence.
 //  2024-04-19: Vulkan: Added convenience support for Volk via IMGUI_IMPL_VULKAN_USE_VOLK define (you can also use IMGUI_IMPL_VULKAN_NO_PROTOTYPES + wrap Volk via ImGui_ImplVulkan_LoadFunctions().)
 //  2024-02-14: *BREAKING CHANGE*: Moved RenderPass parameter from ImGui_ImplVulkan_Init() function to ImGui_ImplVulkan_InitInfo structure. Not required when using dynamic rendering.
 //  2024-02-12: *BREAKING CHANGE*: Dynamic rendering now require filling PipelineRenderingCreateInfo structure.
@@ -98,6 +100,8 @@
 // Forward Declarations
 struct ImGui_ImplVulkan_FrameRenderBuffers;
 struct ImGui_ImplVulkan_WindowRenderBuffers;
+struct ImGui_ImplVulkan_Data;
+struct ImGui_ImplVulkan_Texture;
 bool ImGui_ImplVulkan_CreateDeviceObjects();
 void ImGui_ImplVulkan_DestroyDeviceObjects();
 void ImGui_ImplVulkan_DestroyFrameRenderBuffers(VkDevice device, ImGui_ImplVulkan_FrameRenderBuffers* buffers, const VkAllocationCallbacks* allocator);
@@ -106,6 +110,10 @@ void ImGui_ImplVulkanH_DestroyFrame(VkDevice device, ImGui_ImplVulkanH_Frame* fd
 void ImGui_ImplVulkanH_DestroyFrameSemaphores(VkDevice device, ImGui_ImplVulkanH_FrameSemaphores* fsd, const VkAllocationCallbacks* allocator);
 void ImGui_ImplVulkanH_CreateWindowSwapChain(VkPhysicalDevice physical_device, VkDevice device, ImGui_ImplVulkanH_Window* wd, const VkAllocationCallbacks* allocator, int w, int h, uint32_t min_image_count);
 void ImGui_ImplVulkanH_CreateWindowCommandBuffers(VkPhysicalDevice physical_device, VkDevice device, ImGui_ImplVulkanH_Window* wd, uint32_t queue_family, const VkAllocationCallbacks* allocator);
+static ImTextureID ImGui_ImplVulkan_CreateTexture(ImGuiContext* ctx, int width, int height);
+static void ImGui_ImplVulkan_UpdateTexture(ImGuiContext* ctx, ImTextureID tex_id, const ImTextureRect* rects, int rects_count, const void* pixels, int pitch);
+static void ImGui_ImplVulkan_DestroyTexture(ImGuiContext* ctx, ImTextureID tex_id);
+static void ImGui_ImplVulkan_DestroyTexture(ImGui_ImplVulkan_Data* bd, ImGui_ImplVulkan_Texture* tex);
 
 // Vulkan prototypes for use with custom loaders
 // (see description of IMGUI_IMPL_VULKAN_NO_PROTOTYPES in imgui_impl_vulkan.h
@@ -179,8 +187,10 @@ static bool g_FunctionsLoaded = true;
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkQueueSubmit) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkQueueWaitIdle) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkResetCommandPool) \
+    IMGUI_VULKAN_FUNC_MAP_MACRO(vkResetFences) \
     IMGUI_VULKAN_FUNC_MAP_MACRO(vkUnmapMemory) \
-    IMGUI_VULKAN_FUNC_MAP_MACRO(vkUpdateDescriptorSets)
+    IMGUI_VULKAN_FUNC_MAP_MACRO(vkUpdateDescriptorSets) \
+    IMGUI_VULKAN_FUNC_MAP_MACRO(vkWaitForFences)
 
 // Define function pointers
 #define IMGUI_VULKAN_FUNC_DEF(func) static PFN_##func func;
@@ -214,6 +224,29 @@ struct ImGui_ImplVulkan_WindowRenderBuffers
     ImGui_ImplVulkan_FrameRenderBuffers* FrameRenderBuffers;
 };
 
+// Texture created through io.RendererCreateTextureFn
+// Each one keeps a persistently mapped staging buffer laid out like the texture, and its own command buffer and fence,
+// so that an upload only waits for the previous upload of the same texture (normally done since the previous frame).
+struct ImGui_ImplVulkan_Texture
+{
+    VkImage                     Image;
+    VkDeviceMemory              ImageMemory;
+    VkImageView                 ImageView;
+    VkDescriptorSet             DescriptorSet;
+    VkBuffer                    UploadBuffer;
+    VkDeviceMemory              UploadBufferMemory;
+    unsigned char*              UploadBufferMapped;
+    VkCommandPool               CommandPool;
+    VkCommandBuffer             CommandBuffer;
+    VkFence                     Fence;
+    ImVector<VkBufferImageCopy> Regions;
+    int                         Width, Height;
+    bool                        Submitted;      // Fence will be signaled when the last upload is done
+    bool                        Initialized;    // Image is in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+
+    ImGui_ImplVulkan_Texture()  { memset((void*)this, 0, sizeof(*this)); }
+};
+
 // Vulkan data
 struct ImGui_ImplVulkan_Data
 {
@@ -238,6 +271,9 @@ struct ImGui_ImplVulkan_Data
     // Render buffers for main window
     ImGui_ImplVulkan_WindowRenderBuffers MainWindowRenderBuffers;
 
+    // Textures created through io.RendererCreateTextureFn
+    ImVector<ImGui_ImplVulkan_Texture*> Textures;
+
     ImGui_ImplVulkan_Data()
     {
         memset((void*)this, 0, sizeof(*this));
@@ -366,9 +402,14 @@ static ImGui_ImplVulkan_Data* ImGui_ImplVulkan_GetBackendData()
     return ImGui::GetCurrentContext() ? (ImGui_ImplVulkan_Data*)ImGui::GetIO().BackendRendererUserData : nullptr;
 }
 
-static uint32_t ImGui_ImplVulkan_MemoryType(VkMemoryPropertyFlags properties, uint32_t type_bits)
+// For the texture hooks, which may be called while another context is current (or none)
+static ImGui_ImplVulkan_Data* ImGui_ImplVulkan_GetBackendData(ImGuiContext* ctx)
+{
+    return (ImGui_ImplVulkan_Data*)ImGui::GetIO(ctx).BackendRendererUserData;
+}
+
+static uint32_t ImGui_ImplVulkan_MemoryType(ImGui_ImplVulkan_Data* bd, VkMemoryPropertyFlags properties, uint32_t type_bits)
 {
-    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
     ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
     VkPhysicalDeviceMemoryProperties prop;
     vkGetPhysicalDeviceMemoryProperties(v->PhysicalDevice, &prop);
@@ -378,9 +419,13 @@ static uint32_t ImGui_ImplVulkan_MemoryType(VkMemoryPropertyFlags properties, ui
     return 0xFFFFFFFF; // Unable to find memoryType
 }
 
-static void check_vk_result(VkResult err)
+static uint32_t ImGui_ImplVulkan_MemoryType(VkMemoryPropertyFlags properties, uint32_t type_bits)
+{
+    return ImGui_ImplVulkan_MemoryType(ImGui_ImplVulkan_GetBackendData(), properties, type_bits);
+}
+
+static void check_vk_result(ImGui_ImplVulkan_Data* bd, VkResult err)
 {
-    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
     if (!bd)
         return;
     ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
@@ -388,6 +433,11 @@ static void check_vk_result(VkResult err)
         v->CheckVkResultFn(err);
 }
 
+static void check_vk_result(VkResult err)
+{
+    check_vk_result(ImGui_ImplVulkan_GetBackendData(), err);
+}
+
 // Same as IM_MEMALIGN(). 'alignment' must be a power of two.
 static inline VkDeviceSize AlignBufferSize(VkDeviceSize size, VkDeviceSize alignment)
 {
@@ -1034,6 +1084,10 @@ void    ImGui_ImplVulkan_DestroyDeviceObjects()
     ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
     ImGui_ImplVulkan_DestroyWindowRenderBuffers(v->Device, &bd->MainWindowRenderBuffers, v->Allocator);
     ImGui_ImplVulkan_DestroyFontsTexture();
+    if (bd->Textures.Size > 0)
+        vkQueueWaitIdle(v->Queue);
+    while (bd->Textures.Size > 0)
+        ImGui_ImplVulkan_DestroyTexture(bd, bd->Textures.back());
 
     if (bd->FontCommandBuffer)    { vkFreeCommandBuffers(v->Device, bd->FontCommandPool, 1, &bd->FontCommandBuffer); bd->FontCommandBuffer = VK_NULL_HANDLE; }
     if (bd->FontCommandPool)      { vkDestroyCommandPool(v->Device, bd->FontCommandPool, v->Allocator); bd->FontCommandPool = VK_NULL_HANDLE; }
@@ -1100,6 +1154,10 @@ bool    ImGui_ImplVulkan_Init(ImGui_ImplVulkan_InitInfo* info)
     io.BackendRendererUserData = (void*)bd;
     io.BackendRendererName = "imgui_impl_vulkan";
     io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextureUpdates; // We can create textures and update parts of them.
+    io.RendererCreateTextureFn = ImGui_ImplVulkan_CreateTexture;
+    io.RendererUpdateTextureFn = ImGui_ImplVulkan_UpdateTexture;
+    io.RendererDestroyTextureFn = ImGui_ImplVulkan_DestroyTexture;
 
     IM_ASSERT(info->Instance != VK_NULL_HANDLE);
     IM_ASSERT(info->PhysicalDevice != VK_NULL_HANDLE);
@@ -1127,7 +1185,10 @@ void ImGui_ImplVulkan_Shutdown()
     ImGui_ImplVulkan_DestroyDeviceObjects();
     io.BackendRendererName = nullptr;
     io.BackendRendererUserData = nullptr;
-    io.BackendFlags &= ~ImGuiBackendFlags_RendererHasVtxOffset;
+    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasTextureUpdates);
+    io.RendererCreateTextureFn = nullptr;
+    io.RendererUpdateTextureFn = nullptr;
+    io.RendererDestroyTextureFn = nullptr;
     IM_DELETE(bd);
 }
 
@@ -1156,9 +1217,8 @@ void ImGui_ImplVulkan_SetMinImageCount(uint32_t min_image_count)
 
 // Register a texture
 // FIXME: This is experimental in the sense that we are unsure how to best design/tackle this problem, please post to https://github.com/ocornut/imgui/pull/914 if you have suggestions.
-VkDescriptorSet ImGui_ImplVulkan_AddTexture(VkSampler sampler, VkImageView image_view, VkImageLayout image_layout)
+static VkDescriptorSet ImGui_ImplVulkan_AddTexture(ImGui_ImplVulkan_Data* bd, VkSampler sampler, VkImageView image_view, VkImageLayout image_layout)
 {
-    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
     ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
 
     // Create Descriptor Set:
@@ -1190,13 +1250,273 @@ VkDescriptorSet ImGui_ImplVulkan_AddTexture(VkSampler sampler, VkImageView image
     return descriptor_set;
 }
 
-void ImGui_ImplVulkan_RemoveTexture(VkDescriptorSet descriptor_set)
+VkDescriptorSet ImGui_ImplVulkan_AddTexture(VkSampler sampler, VkImageView image_view, VkImageLayout image_layout)
+{
+    return ImGui_ImplVulkan_AddTexture(ImGui_ImplVulkan_GetBackendData(), sampler, image_view, image_layout);
+}
+
+static void ImGui_ImplVulkan_RemoveTexture(ImGui_ImplVulkan_Data* bd, VkDescriptorSet descriptor_set)
 {
-    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
     ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
     vkFreeDescriptorSets(v->Device, v->DescriptorPool, 1, &descriptor_set);
 }
 
+void ImGui_ImplVulkan_RemoveTexture(VkDescriptorSet descriptor_set)
+{
+    ImGui_ImplVulkan_RemoveTexture(ImGui_ImplVulkan_GetBackendData(), descriptor_set);
+}
+
+// Textures created through io.RendererCreateTextureFn, e.g. for widgets drawing into a CPU-side surface.
+// Each one needs a descriptor set from ImGui_ImplVulkan_InitInfo::DescriptorPool.
+static ImTextureID ImGui_ImplVulkan_CreateTexture(ImGuiContext* ctx, int width, int height)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData(ctx);
+    ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
+    ImGui_ImplVulkan_Texture* tex = IM_NEW(ImGui_ImplVulkan_Texture)();
+    tex->Width = width;
+    tex->Height = height;
+    VkResult err;
+
+    // Create the Image:
+    {
+        VkImageCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        info.imageType = VK_IMAGE_TYPE_2D;
+        info.format = VK_FORMAT_R8G8B8A8_UNORM;
+        info.extent.width = width;
+        info.extent.height = height;
+        info.extent.depth = 1;
+        info.mipLevels = 1;
+        info.arrayLayers = 1;
+        info.samples = VK_SAMPLE_COUNT_1_BIT;
+        info.tiling = VK_IMAGE_TILING_OPTIMAL;
+        info.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        err = vkCreateImage(v->Device, &info, v->Allocator, &tex->Image);
+        check_vk_result(bd, err);
+        VkMemoryRequirements req;
+        vkGetImageMemoryRequirements(v->Device, tex->Image, &req);
+        VkMemoryAllocateInfo alloc_info = {};
+        alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        alloc_info.allocationSize = IM_MAX(v->MinAllocationSize, req.size);
+        alloc_info.memoryTypeIndex = ImGui_ImplVulkan_MemoryType(bd, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, req.memoryTypeBits);
+        err = vkAllocateMemory(v->Device, &alloc_info, v->Allocator, &tex->ImageMemory);
+        check_vk_result(bd, err);
+        err = vkBindImageMemory(v->Device, tex->Image, tex->ImageMemory, 0);
+        check_vk_result(bd, err);
+    }
+
+    // Create the Image View and the Descriptor Set:
+    {
+        VkImageViewCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        info.image = tex->Image;
+        info.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        info.format = VK_FORMAT_R8G8B8A8_UNORM;
+        info.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        info.subresourceRange.levelCount = 1;
+        info.subresourceRange.layerCount = 1;
+        err = vkCreateImageView(v->Device, &info, v->Allocator, &tex->ImageView);
+        check_vk_result(bd, err);
+    }
+    tex->DescriptorSet = ImGui_ImplVulkan_AddTexture(bd, bd->FontSampler, tex->ImageView, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+    // Create the Upload Buffer, kept mapped:
+    {
+        VkBufferCreateInfo buffer_info = {};
+        buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        buffer_info.size = (VkDeviceSize)width * height * 4;
+        buffer_info.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        err = vkCreateBuffer(v->Device, &buffer_info, v->Allocator, &tex->UploadBuffer);
+        check_vk_result(bd, err);
+        VkMemoryRequirements req;
+        vkGetBufferMemoryRequirements(v->Device, tex->UploadBuffer, &req);
+        VkMemoryAllocateInfo alloc_info = {};
+        alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        alloc_info.allocationSize = IM_MAX(v->MinAllocationSize, req.size);
+        alloc_info.memoryTypeIndex = ImGui_ImplVulkan_MemoryType(bd, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, req.memoryTypeBits);
+        err = vkAllocateMemory(v->Device, &alloc_info, v->Allocator, &tex->UploadBufferMemory);
+        check_vk_result(bd, err);
+        err = vkBindBufferMemory(v->Device, tex->UploadBuffer, tex->UploadBufferMemory, 0);
+        check_vk_result(bd, err);
+        err = vkMapMemory(v->Device, tex->UploadBufferMemory, 0, VK_WHOLE_SIZE, 0, (void**)&tex->UploadBufferMapped);
+        check_vk_result(bd, err);
+    }
+
+    // Create command pool/buffer and fence
+    {
+        VkCommandPoolCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        info.queueFamilyIndex = v->QueueFamily;
+        err = vkCreateCommandPool(v->Device, &info, v->Allocator, &tex->CommandPool);
+        check_vk_result(bd, err);
+    }
+    {
+        VkCommandBufferAllocateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        info.commandPool = tex->CommandPool;
+        info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        info.commandBufferCount = 1;
+        err = vkAllocateCommandBuffers(v->Device, &info, &tex->CommandBuffer);
+        check_vk_result(bd, err);
+    }
+    {
+        VkFenceCreateInfo info = {};
+        info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        err = vkCreateFence(v->Device, &info, v->Allocator, &tex->Fence);
+        check_vk_result(bd, err);
+    }
+
+    bd->Textures.push_back(tex);
+    return (ImTextureID)tex->DescriptorSet;
+}
+
+static ImGui_ImplVulkan_Texture* ImGui_ImplVulkan_FindTexture(ImGui_ImplVulkan_Data* bd, ImTextureID tex_id)
+{
+    for (ImGui_ImplVulkan_Texture* tex : bd->Textures)
+        if ((ImTextureID)tex->DescriptorSet == tex_id)
+            return tex;
+    return nullptr;
+}
+
+static void ImGui_ImplVulkan_UpdateTexture(ImGuiContext* ctx, ImTextureID tex_id, const ImTextureRect* rects, int rects_count, const void* pixels, int pitch)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData(ctx);
+    ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
+    ImGui_ImplVulkan_Texture* tex = ImGui_ImplVulkan_FindTexture(bd, tex_id);
+    IM_ASSERT(tex != nullptr && "Texture wasn't created by io.RendererCreateTextureFn!");
+    if (rects_count <= 0)
+        return;
+    VkResult err;
+
+    // Wait for the previous upload to be done with the upload buffer
+    if (tex->Submitted)
+    {
+        err = vkWaitForFences(v->Device, 1, &tex->Fence, VK_TRUE, UINT64_MAX);
+        check_vk_result(bd, err);
+        err = vkResetFences(v->Device, 1, &tex->Fence);
+        check_vk_result(bd, err);
+        tex->Submitted = false;
+    }
+
+    // Upload to Buffer, at the same place as in the texture:
+    tex->Regions.resize(0);
+    for (int n = 0; n < rects_count; n++)
+    {
+        const ImTextureRect& r = rects[n];
+        const size_t offset = ((size_t)r.y * tex->Width + r.x) * 4;
+        for (int y = 0; y < r.h; y++)
+            memcpy(tex->UploadBufferMapped + offset + (size_t)y * tex->Width * 4, (const unsigned char*)pixels + (size_t)(r.y + y) * pitch + (size_t)r.x * 4, (size_t)r.w * 4);
+
+        VkBufferImageCopy region = {};
+        region.bufferOffset = offset;
+        region.bufferRowLength = tex->Width;
+        region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        region.imageSubresource.layerCount = 1;
+        region.imageOffset.x = r.x;
+        region.imageOffset.y = r.y;
+        region.imageExtent.width = r.w;
+        region.imageExtent.height = r.h;
+        region.imageExtent.depth = 1;
+        tex->Regions.push_back(region);
+    }
+    {
+        VkMappedMemoryRange range[1] = {};
+        range[0].sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+        range[0].memory = tex->UploadBufferMemory;
+        range[0].size = VK_WHOLE_SIZE;
+        err = vkFlushMappedMemoryRanges(v->Device, 1, range);
+        check_vk_result(bd, err);
+    }
+
+    // Start command buffer
+    {
+        err = vkResetCommandPool(v->Device, tex->CommandPool, 0);
+        check_vk_result(bd, err);
+        VkCommandBufferBeginInfo begin_info = {};
+        begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        begin_info.flags |= VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        err = vkBeginCommandBuffer(tex->CommandBuffer, &begin_info);
+        check_vk_result(bd, err);
+    }
+
+    // Copy to Image, after the fragment shaders of previously submitted frames are done reading it:
+    {
+        VkImageMemoryBarrier copy_barrier[1] = {};
+        copy_barrier[0].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        copy_barrier[0].srcAccessMask = tex->Initialized ? VK_ACCESS_SHADER_READ_BIT : 0;
+        copy_barrier[0].dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        copy_barrier[0].oldLayout = tex->Initialized ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_UNDEFINED;
+        copy_barrier[0].newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        copy_barrier[0].srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        copy_barrier[0].dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        copy_barrier[0].image = tex->Image;
+        copy_barrier[0].subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        copy_barrier[0].subresourceRange.levelCount = 1;
+        copy_barrier[0].subresourceRange.layerCount = 1;
+        vkCmdPipelineBarrier(tex->CommandBuffer, VK_PIPELINE_STAGE_HOST_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, copy_barrier);
+
+        vkCmdCopyBufferToImage(tex->CommandBuffer, tex->UploadBuffer, tex->Image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, (uint32_t)tex->Regions.Size, tex->Regions.Data);
+
+        VkImageMemoryBarrier use_barrier[1] = {};
+        use_barrier[0].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        use_barrier[0].srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        use_barrier[0].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        use_barrier[0].oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        use_barrier[0].newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        use_barrier[0].srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        use_barrier[0].dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        use_barrier[0].image = tex->Image;
+        use_barrier[0].subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        use_barrier[0].subresourceRange.levelCount = 1;
+        use_barrier[0].subresourceRange.layerCount = 1;
+        vkCmdPipelineBarrier(tex->CommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, use_barrier);
+    }
+
+    // End command buffer, submit without waiting
+    VkSubmitInfo end_info = {};
+    end_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    end_info.commandBufferCount = 1;
+    end_info.pCommandBuffers = &tex->CommandBuffer;
+    err = vkEndCommandBuffer(tex->CommandBuffer);
+    check_vk_result(bd, err);
+    err = vkQueueSubmit(v->Queue, 1, &end_info, tex->Fence);
+    check_vk_result(bd, err);
+    tex->Submitted = true;
+    tex->Initialized = true;
+}
+
+static void ImGui_ImplVulkan_DestroyTexture(ImGui_ImplVulkan_Data* bd, ImGui_ImplVulkan_Texture* tex)
+{
+    ImGui_ImplVulkan_InitInfo* v = &bd->VulkanInitInfo;
+    bd->Textures.find_erase_unsorted(tex);
+
+    if (tex->DescriptorSet)         { ImGui_ImplVulkan_RemoveTexture(bd, tex->DescriptorSet); }
+    if (tex->ImageView)             { vkDestroyImageView(v->Device, tex->ImageView, v->Allocator); }
+    if (tex->Image)                 { vkDestroyImage(v->Device, tex->Image, v->Allocator); }
+    if (tex->ImageMemory)           { vkFreeMemory(v->Device, tex->ImageMemory, v->Allocator); }
+    if (tex->UploadBufferMapped)    { vkUnmapMemory(v->Device, tex->UploadBufferMemory); }
+    if (tex->UploadBuffer)          { vkDestroyBuffer(v->Device, tex->UploadBuffer, v->Allocator); }
+    if (tex->UploadBufferMemory)    { vkFreeMemory(v->Device, tex->UploadBufferMemory, v->Allocator); }
+    if (tex->CommandBuffer)         { vkFreeCommandBuffers(v->Device, tex->CommandPool, 1, &tex->CommandBuffer); }
+    if (tex->CommandPool)           { vkDestroyCommandPool(v->Device, tex->CommandPool, v->Allocator); }
+    if (tex->Fence)                 { vkDestroyFence(v->Device, tex->Fence, v->Allocator); }
+    IM_DELETE(tex);
+}
+
+static void ImGui_ImplVulkan_DestroyTexture(ImGuiContext* ctx, ImTextureID tex_id)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData(ctx);
+    ImGui_ImplVulkan_Texture* tex = ImGui_ImplVulkan_FindTexture(bd, tex_id);
+    IM_ASSERT(tex != nullptr && "Texture wasn't created by io.RendererCreateTextureFn!");
+
+    // Frames still in flight may be sampling it
+    vkQueueWaitIdle(bd->VulkanInitInfo.Queue);
+    ImGui_ImplVulkan_DestroyTexture(bd, tex);
+}
+
 void ImGui_ImplVulkan_DestroyFrameRenderBuffers(VkDevice device, ImGui_ImplVulkan_FrameRenderBuffers* buffers, const VkAllocationCallbacks* allocator)
 {
     if (buffers->VertexBuffer) { vkDestroyBuffer(device, buffers->VertexBuffer, allocator); buffers->VertexBuffer = VK_NULL_HANDLE; }
@@ -0,0 +1,16 @@
+// dear imgui: helpers shared by the "null" tests (test_*.cpp)
+// - CHECK() prints the expression and location of a failed check and counts it. The count is atomic, so threads may CHECK() too.
+// - End main() with 'return TestReport(__FILE__);' to print the result line and return non-zero on failure.
+#pragma once
+
+#include <stdio.h>
+#include <atomic>
+
+static std::atomic<int> g_Failures{ 0 };
+#define CHECK(_EXPR)    do { if (!(_EXPR)) { printf("%s(%d): FAILED: %s\n", __FILE__, __LINE__, #_EXPR); g_Failures++; } } while (0)
+
+static inline int TestReport(const char* file)
+{
+    printf("%s: %s\n", file, g_Failures ? "FAILED" : "OK");
+    return g_Failures ? 1 : 0;
+}
@@ -0,0 +1,203 @@
+// dear imgui: "null" ig::ImageSurface test
+// (headless, uploads through a recording stub renderer, returns non-zero on failure)
+// - The stub implements io.RendererCreateTextureFn/UpdateTextureFn/DestroyTextureFn over a CPU copy of the texture,
+//   and records the rects of every update.
+// - After every Upload(), the copy must match the surface, and only the tiles written to must have been sent.
+// - Textures must be destroyed through the context owning them, whichever is current, and with that context if it goes first.
+#include "imgui.h"
+#include "imgui_modern.h"
+#include "test_harness.h"
+#include <string.h>
+#include <memory>
+#include <vector>
+
+namespace ig = ghassanpl::ig;
+
+struct StubTexture
+{
+    ImGuiContext*               Context;        // Context which created it, which every other hook call must pass
+    int                         Width, Height;
+    std::vector<ImU32>          Texels;
+    std::vector<ImTextureRect>  LastRects;      // Rects of the last update
+    int                         UpdateCount = 0;
+};
+static int g_DestroyedTextures = 0;
+
+static ImTextureID StubRenderer_CreateTexture(ImGuiContext* ctx, int width, int height)
+{
+    StubTexture* tex = new StubTexture();
+    tex->Context = ctx;
+    tex->Width = width;
+    tex->Height = height;
+    tex->Texels.assign((size_t)width * height, 0xDEADBEEF);
+    return (ImTextureID)tex;
+}
+
+static void StubRenderer_UpdateTexture(ImGuiContext* ctx, ImTextureID tex_id, const ImTextureRect* rects, int rects_count, const void* pixels, int pitch)
+{
+    StubTexture* tex = (StubTexture*)tex_id;
+    CHECK(ctx == tex->Context);
+    tex->LastRects.assign(rects, rects + rects_count);
+    tex->UpdateCount++;
+    for (int n = 0; n < rects_count; n++)
+    {
+        const ImTextureRect& r = rects[n];
+        CHECK(r.x >= 0 && r.y >= 0 && r.w > 0 && r.h > 0 && r.x + r.w <= tex->Width && r.y + r.h <= tex->Height);
+        for (int y = r.y; y < r.y + r.h; y++)
+            memcpy(&tex->Texels[(size_t)y * tex->Width + r.x], (const char*)pixels + (size_t)y * pitch + r.x * sizeof(ImU32), r.w * sizeof(ImU32));
+    }
+}
+
+static void StubRenderer_DestroyTexture(ImGuiContext* ctx, ImTextureID tex_id)
+{
+    CHECK(ctx == ((StubTexture*)tex_id)->Context);
+    delete (StubTexture*)tex_id;
+    g_DestroyedTextures++;
+}
+
+static bool TextureMatches(const ig::ImageSurface& surface)
+{
+    const StubTexture* tex = (const StubTexture*)surface.TextureID();
+    return tex != NULL && memcmp(tex->Texels.data(), surface.Pixels(), tex->Texels.size() * sizeof(ImU32)) == 0;
+}
+
+// Texels sent by the last update; rects must not overlap
+static int LastUpdateArea(const ig::ImageSurface& surface)
+{
+    const StubTexture* tex = (const StubTexture*)surface.TextureID();
+    int area = 0;
+    for (size_t i = 0; i < tex->LastRects.size(); i++)
+    {
+        const ImTextureRect& a = tex->LastRects[i];
+        area += a.w * a.h;
+        for (size_t j = i + 1; j < tex->LastRects.size(); j++)
+        {
+            const ImTextureRect& b = tex->LastRects[j];
+            CHECK(a.x + a.w <= b.x || b.x + b.w <= a.x || a.y + a.h <= b.y || b.y + b.h <= a.y);
+        }
+    }
+    return area;
+}
+
+static ImGuiContext* CreateTestContext(bool with_texture_updates)
+{
+    ImGuiContext* ctx = ImGui::CreateContext();
+    ImGui::SetCurrentContext(ctx);
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.0f / 60.0f;
+    unsigned char* tex_pixels = NULL;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+    if (with_texture_updates)
+    {
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasTextureUpdates;
+        io.RendererCreateTextureFn = StubRenderer_CreateTexture;
+        io.RendererUpdateTextureFn = StubRenderer_UpdateTexture;
+        io.RendererDestroyTextureFn = StubRenderer_DestroyTexture;
+    }
+    return ctx;
+}
+
+int main(int, char**)
+{
+    IMGUI_CHECKVERSION();
+    ImGuiContext* ctx = CreateTestContext(false);
+
+    {
+        // Without texture updates, nothing is created
+        ig::ImageSurface surface(100, 100);
+        CHECK(surface.Upload() == false);
+        CHECK(surface.TextureID() == NULL);
+    }
+
+    ImGui::DestroyContext(ctx);
+    ctx = CreateTestContext(true);
+    {
+        // 4x3 tiles, the last column and row of tiles being partial
+        const int T = ig::ImageSurface::TileSize;
+        ig::ImageSurface surface(T * 3 + 10, T * 2 + 20, IM_COL32(10, 20, 30, 255));
+
+        // First upload sends everything
+        CHECK(surface.Upload());
+        StubTexture* tex = (StubTexture*)surface.TextureID();
+        CHECK(tex != NULL && tex->UpdateCount == 1);
+        CHECK(TextureMatches(surface));
+        CHECK(LastUpdateArea(surface) == surface.Width() * surface.Height());
+        CHECK(!surface.IsDirty());
+
+        // Nothing dirty: no update
+        CHECK(surface.Upload());
+        CHECK(tex->UpdateCount == 1);
+
+        // One pixel: its tile only
+        surface.SetPixel(T + 5, 3, IM_COL32_WHITE);
+        CHECK(surface.Upload());
+        CHECK(tex->UpdateCount == 2 && tex->LastRects.size() == 1);
+        CHECK(tex->LastRects[0].x == T && tex->LastRects[0].y == 0 && tex->LastRects[0].w == T && tex->LastRects[0].h == T);
+        CHECK(TextureMatches(surface));
+
+        // A pixel in the bottom-right partial tile
+        surface.SetPixel(surface.Width() - 1, surface.Height() - 1, IM_COL32_WHITE);
+        CHECK(surface.Upload());
+        CHECK(tex->LastRects.size() == 1);
+        CHECK(tex->LastRects[0].x == T * 3 && tex->LastRects[0].y == T * 2 && tex->LastRects[0].w == 10 && tex->LastRects[0].h == 20);
+        CHECK(TextureMatches(surface));
+
+        // A rect over 2x2 tiles, and a pixel away from it: 4 + 1 tiles, in non-overlapping rects
+        surface.Fill(T - 2, T - 2, 4, 4, IM_COL32(255, 0, 0, 255));
+        surface.SetPixel(3, T * 2 + 1, IM_COL32(0, 255, 0, 255));
+        CHECK(surface.Upload());
+        CHECK(LastUpdateArea(surface) == 4 * T * T + T * 20);
+        CHECK(TextureMatches(surface));
+
+        // Direct writes are sent once marked
+        surface.Pixels()[0] = IM_COL32(1, 2, 3, 4);
+        surface.MarkDirty(0, 0, 1, 1);
+        CHECK(surface.Upload());
+        CHECK(LastUpdateArea(surface) == T * T);
+        CHECK(TextureMatches(surface));
+
+        // Heatmap over the whole surface, drawn in a frame
+        std::vector<float> values((size_t)surface.Width() * surface.Height());
+        for (size_t i = 0; i < values.size(); i++)
+            values[i] = (float)(i % 97) / 96.0f;
+        surface.Heatmap(values, 0.0f, 1.0f);
+        ImGui::NewFrame();
+        ImGui::Begin("Surface");
+        surface.Image();
+        ImGui::End();
+        ImGui::Render();
+        CHECK(LastUpdateArea(surface) == surface.Width() * surface.Height());
+        CHECK(TextureMatches(surface));
+        CHECK(surface.Pixel(0, 0) == ig::ImageSurface::HeatmapColormap()[0]);
+    }
+    CHECK(g_DestroyedTextures == 1);
+
+    {
+        // Destroyed while another context is current, then while none is
+        auto surface_a = std::make_unique<ig::ImageSurface>(10, 10);
+        auto surface_b = std::make_unique<ig::ImageSurface>(10, 10);
+        CHECK(surface_a->Upload() && surface_b->Upload());
+        ImGuiContext* other_ctx = CreateTestContext(true);
+        surface_a.reset();
+        CHECK(g_DestroyedTextures == 2);
+        ImGui::DestroyContext(other_ctx);
+        CHECK(ImGui::GetCurrentContext() == NULL);
+        surface_b.reset();
+        CHECK(g_DestroyedTextures == 3);
+    }
+
+    {
+        // Outliving its context: the texture goes with the context
+        ig::ImageSurface surface(10, 10);
+        ImGui::SetCurrentContext(ctx);
+        CHECK(surface.Upload());
+        ImGui::DestroyContext(ctx);
+        CHECK(g_DestroyedTextures == 4);
+        CHECK(surface.TextureID() == NULL);
+    }
+    CHECK(g_DestroyedTextures == 4);
+    return TestReport(__FILE__);
+}
@@ -0,0 +1,158 @@
+// dear imgui: "null" settings test
+// (headless, saves and reloads .ini settings in both text and binary formats, returns non-zero on failure)
+// - Window and Table handlers are stored as binary blocks, the two user handlers below as text (version 0) blocks.
+// - Their output ends with blank lines, as most handlers do, to check that parsing a text block never reads or
+//   writes outside of it (which used to corrupt the header of the following block).
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "test_harness.h"
+#include <string.h>
+
+struct UserSettings
+{
+    int     ValueA = 0;
+    int     ValueB = 0;
+};
+static UserSettings g_User;
+
+static void* UserHandler_ReadOpen(ImGuiContext*, ImGuiSettingsHandler*, const char*) { return (void*)1; }
+static void UserHandler_ReadLine(ImGuiContext*, ImGuiSettingsHandler* handler, void*, const char* line)
+{
+    int v;
+    if (sscanf(line, "Value=%d", &v) == 1)
+        (strcmp(handler->TypeName, "UserA") == 0 ? g_User.ValueA : g_User.ValueB) = v;
+}
+static void UserHandler_WriteAll(ImGuiContext*, ImGuiSettingsHandler* handler, ImGuiTextBuffer* buf)
+{
+    const int value = (strcmp(handler->TypeName, "UserA") == 0) ? g_User.ValueA : g_User.ValueB;
+    buf->appendf("[%s][Data]\nValue=%d\n\n", handler->TypeName, value);
+}
+
+static ImGuiContext* CreateTestContext()
+{
+    ImGuiContext* ctx = ImGui::CreateContext();
+    ImGui::SetCurrentContext(ctx);
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.0f / 60.0f;
+    unsigned char* tex_pixels = NULL;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+
+    const char* names[] = { "UserA", "UserB" };
+    for (const char* name : names)
+    {
+        ImGuiSettingsHandler handler;
+        handler.TypeName = name;
+        handler.TypeHash = ImHashStr(name);
+        handler.ReadOpenFn = UserHandler_ReadOpen;
+        handler.ReadLineFn = UserHandler_ReadLine;
+        handler.WriteAllFn = UserHandler_WriteAll;
+        ImGui::AddSettingsHandler(&handler);
+    }
+    return ctx;
+}
+
+static void SubmitFrame(int table_column_width)
+{
+    ImGui::NewFrame();
+    for (int n = 0; n < 3; n++)
+    {
+        char name[16];
+        ImFormatString(name, IM_ARRAYSIZE(name), "Window %d", n);
+        ImGui::SetNextWindowPos(ImVec2(10.0f + n * 100.0f, 20.0f + n * 10.0f), ImGuiCond_FirstUseEver);
+        ImGui::SetNextWindowSize(ImVec2(200.0f, 150.0f), ImGuiCond_FirstUseEver);
+        ImGui::Begin(name);
+        if (n == 0 && ImGui::BeginTable("Table", 2, ImGuiTableFlags_Resizable))
+        {
+            ImGui::TableSetupColumn("A", ImGuiTableColumnFlags_WidthFixed, (float)table_column_width);
+            ImGui::TableSetupColumn("B", ImGuiTableColumnFlags_WidthFixed, 30.0f);
+            ImGui::TableNextColumn();
+            ImGui::Text("A");
+            ImGui::EndTable();
+        }
+        ImGui::End();
+    }
+    ImGui::Render();
+}
+
+static ImVector<char> SaveSettings()
+{
+    size_t size = 0;
+    const char* data = ImGui::SaveIniSettingsToMemory(&size);
+    ImVector<char> out;
+    out.resize((int)size);
+    memcpy(out.Data, data, size);
+    return out;
+}
+
+// Load 'data' into a new context and check that every handler got its data back
+static void CheckLoad(const ImVector<char>& data, ImVec2 expected_window1_pos, int expected_a, int expected_b)
+{
+    ImGuiContext* ctx = CreateTestContext();
+    g_User = UserSettings();
+    ImGui::LoadIniSettingsFromMemory(ImStrv(data.Data, data.Data + data.Size));
+    CHECK(g_User.ValueA == expected_a);
+    CHECK(g_User.ValueB == expected_b);
+
+    ImGuiWindowSettings* settings = ImGui::FindWindowSettingsByID(ImHashStr("Window 1"));
+    CHECK(settings != NULL);
+    if (settings != NULL)
+        CHECK(settings->Pos.x == (short)expected_window1_pos.x && settings->Pos.y == (short)expected_window1_pos.y);
+    CHECK(ImGui::FindWindowSettingsByID(ImHashStr("Window 2")) != NULL);
+
+    SubmitFrame(50);
+    ImGuiWindow* window0 = ImGui::FindWindowByName("Window 0");
+    ImGuiTable* table = window0 ? ImGui::TableFindByID(ImHashStr("Table", 0, window0->ID)) : NULL;
+    CHECK(table != NULL);
+    if (table != NULL)
+        CHECK(table->Columns[0].WidthRequest == 80.0f);
+    ImGui::DestroyContext(ctx);
+}
+
+int main(int, char**)
+{
+    IMGUI_CHECKVERSION();
+    ImGuiContext* ctx = CreateTestContext();
+    g_User.ValueA = 12;
+    g_User.ValueB = 34;
+    SubmitFrame(50);
+
+    // Resize the first table column, as done by the user dragging its border
+    ImGuiTable* table = ImGui::TableFindByID(ImHashStr("Table", 0, ImGui::FindWindowByName("Window 0")->ID));
+    table->Columns[0].WidthRequest = 80.0f;
+    table->Columns[0].WidthAuto = 80.0f;
+    table->Columns[0].AutoFitQueue = 0;
+    table->Columns[0].CannotSkipItemsQueue = 0;
+    table->IsSettingsDirty = true;
+    SubmitFrame(50);
+
+    // Text
+    ImGui::GetIO().IniSaveBinary = false;
+    ImVector<char> text_data = SaveSettings();
+    CheckLoad(text_data, ImVec2(110, 30), 12, 34);
+
+    // Binary, full save
+    ImGui::SetCurrentContext(ctx);
+    ImGui::GetIO().IniSaveBinary = true;
+    ImVector<char> binary_data = SaveSettings();
+    CHECK(binary_data.Size > 0 && binary_data[0] == 0);
+    CheckLoad(binary_data, ImVec2(110, 30), 12, 34);
+
+    // Binary, incremental save: moving a window without MarkIniSettingsDirty() must not reuse the previous Window block
+    ImGui::SetCurrentContext(ctx);
+    ImGui::FindWindowByName("Window 1")->Pos = ImVec2(500, 600);
+    g_User.ValueB = 56;
+    ImVector<char> binary_data_2 = SaveSettings();
+    CheckLoad(binary_data_2, ImVec2(500, 600), 12, 56);
+
+    // Binary, nothing changed
+    ImGui::SetCurrentContext(ctx);
+    ImVector<char> binary_data_3 = SaveSettings();
+    CHECK(binary_data_3.Size == binary_data_2.Size && memcmp(binary_data_3.Data, binary_data_2.Data, binary_data_3.Size) == 0);
+
+    ImGui::SetCurrentContext(ctx);
+    ImGui::DestroyContext(ctx);
+    return TestReport(__FILE__);
+}
@@ -0,0 +1,112 @@
+// dear imgui: "null" multi-threaded contexts test
+// (headless, runs one context per thread concurrently, returns non-zero on failure)
+// - Requires IMGUI_THREAD_LOCAL_CONTEXT (defined for all tests by the Makefile).
+// - Meant to be run under ThreadSanitizer: 'make test WITH_TSAN=1'. Without it, it only checks that every thread completes and gets its own toasts.
+// - Each thread builds its own font atlas and submits core and ig:: widgets which keep state (tables, settings, group panels, combo boxes, toasts).
+#include "imgui.h"
+#include "imgui_modern.h"
+#include "test_harness.h"
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#ifndef IMGUI_THREAD_LOCAL_CONTEXT
+#error "This test requires IMGUI_THREAD_LOCAL_CONTEXT"
+#endif
+
+namespace ig = ghassanpl::ig;
+
+static const int        CONTEXTS_COUNT = 16;
+static const int        FRAMES_COUNT = 60;
+static std::atomic<int> g_CompletedFrames{ 0 };
+
+static void RunContext(int context_n)
+{
+    ImGuiContext* ctx = ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(1280, 720);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.Fonts->AddFontDefault();
+    unsigned char* tex_pixels = NULL;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+
+    std::vector<std::string> names;
+    for (int n = 0; n < 100; n++)
+        names.push_back("Item " + std::to_string(n * CONTEXTS_COUNT + context_n));
+    std::vector<std::string_view> items(names.begin(), names.end());
+    std::string combo_text = "Item";
+    float value = 0.0f;
+
+    for (int frame = 0; frame < FRAMES_COUNT; frame++)
+    {
+        io.MousePos = ImVec2((float)(frame * 7 % 1280), (float)(frame * 13 % 720));
+        io.MouseDown[0] = (frame % 10) < 5;
+        ImGui::NewFrame();
+
+        ImGui::Begin("Window");
+        ImGui::Text("Context %d, frame %d", context_n, frame);
+        ImGui::SliderFloat("Value", &value, 0.0f, 1.0f);
+
+        ig::BeginGroupPanel("Panel", ImVec2(-1.0f, 0.0f));
+        ig::BeginGroupPanel("Nested", ImVec2(200.0f, 0.0f));
+        ImGui::TextUnformatted("Inside");
+        ig::EndGroupPanel();
+        ig::TextInputComboBox("Combo", combo_text, items);
+        ig::EndGroupPanel();
+
+        if (ImGui::BeginTable("Table", 4, ImGuiTableFlags_Resizable | ImGuiTableFlags_Reorderable | ImGuiTableFlags_Sortable | ImGuiTableFlags_ScrollY, ImVec2(0.0f, 200.0f)))
+        {
+            ImGui::TableSetupColumn("A");
+            ImGui::TableSetupColumn("B");
+            ImGui::TableSetupColumn("C");
+            ImGui::TableSetupColumn("D");
+            ImGui::TableHeadersRow();
+            ImGuiListClipper clipper;
+            clipper.Begin(1000);
+            while (clipper.Step())
+                for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+                {
+                    ImGui::TableNextRow();
+                    for (int column = 0; column < 4; column++)
+                    {
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%d,%d", row, column);
+                    }
+                }
+            ImGui::EndTable();
+        }
+        ImGui::End();
+
+        // The same toast every 10 frames: shown once, the other pushes coalesced into it, whatever other contexts push
+        if (frame % 10 == 0)
+            ig::PushToast(ig::ToastType::Info, "Context " + std::to_string(context_n), {}, std::chrono::minutes(1));
+        ig::RenderToasts();
+
+        ImGui::Render();
+        if (frame % 20 == 19)
+            ImGui::SaveIniSettingsToMemory();
+        g_CompletedFrames++;
+    }
+
+    CHECK(ig::Toasts().VisibleCount() == 1);
+    CHECK(ig::Toasts().CoalescedCount() == FRAMES_COUNT / 10 - 1);
+    ImGui::DestroyContext(ctx);
+}
+
+int main(int, char**)
+{
+    IMGUI_CHECKVERSION();
+    std::vector<std::thread> threads;
+    for (int n = 0; n < CONTEXTS_COUNT; n++)
+        threads.emplace_back(RunContext, n);
+    for (std::thread& thread : threads)
+        thread.join();
+
+    CHECK(g_CompletedFrames == CONTEXTS_COUNT * FRAMES_COUNT);
+    return TestReport(__FILE__);
+}
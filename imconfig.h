@@ -52,6 +52,18 @@
 //#define IMGUI_DISABLE_DEFAULT_ALLOCATORS                  // Don't implement default allocators calling malloc()/free() to avoid linking with them. You will need to call ImGui::SetAllocatorFunctions().
 //#define IMGUI_DISABLE_SSE                                 // Disable use of SSE intrinsics even if available
 
+//---- Make the current context pointer thread-local, so that N threads can each run their own context(s) concurrently. Not supported with DLL builds.
+// See "Current context pointer" comments in imgui.cpp for restrictions.
+//#define IMGUI_THREAD_LOCAL_CONTEXT
+
+//---- Serve transient allocations (clipboard conversions, etc.) from a per-context arena reset by NewFrame(), instead of MemAlloc()/MemFree().
+// Its usage and high-water mark are reported in Metrics/Debugger->Memory allocations.
+//#define IMGUI_ENABLE_FRAME_ARENA
+
+//---- Write the .ini file from a background thread (uses std::thread), so NewFrame() never waits on disk when settings are saved.
+// The file is written to a temporary file then renamed over the destination. Requires the default file functions.
+//#define IMGUI_ENABLE_ASYNC_INI_SAVING
+
 //---- Enable Test Engine / Automation features.
 //#define IMGUI_ENABLE_TEST_ENGINE                          // Enable imgui_test_engine hooks. Generally set automatically by include "imgui_te_config.h", see Test Engine for details.
 
@@ -72,6 +72,7 @@ CODE
 // [SECTION] ImGuiStorage
 // [SECTION] ImGuiTextFilter
 // [SECTION] ImGuiTextBuffer, ImGuiTextIndex
+// [SECTION] ImFrameArena
 // [SECTION] ImGuiListClipper
 // [SECTION] STYLING
 // [SECTION] RENDER HELPERS
@@ -1027,6 +1028,14 @@ CODE
 // System includes
 #include <stdio.h>      // vsnprintf, sscanf, printf
 #include <stdint.h>     // intptr_t
+#ifdef IMGUI_ENABLE_ASYNC_INI_SAVING
+#if defined(IMGUI_DISABLE_FILE_FUNCTIONS) || defined(IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS)
+#error "IMGUI_ENABLE_ASYNC_INI_SAVING requires the default file functions."
+#endif
+#include <condition_variable>
+#include <mutex>
+#include <thread>       // std::thread for the background .ini writer
+#endif
 
 // [Windows] On non-Visual Studio compilers, we default to IMGUI_DISABLE_WIN32_DEFAULT_IME_FUNCTIONS unless explicitly enabled
 #if defined(_WIN32) && !defined(_MSC_VER) && !defined(IMGUI_ENABLE_WIN32_DEFAULT_IME_FUNCTIONS) && !defined(IMGUI_DISABLE_WIN32_DEFAULT_IME_FUNCTIONS)
@@ -1134,11 +1143,21 @@ static ImVec2           CalcNextScrollFromScrollTargetAndClamp(ImGuiWindow* wind
 static void             AddWindowToSortBuffer(ImVector<ImGuiWindow*>* out_sorted_windows, ImGuiWindow* window);
 
 // Settings
+static bool             IsIniSettingsBinary(const char* data, size_t data_size);
+static void             LoadIniSettingsText(ImGuiContext* ctx, char* buf, char* buf_end);
+static void             LoadIniSettingsBinary(ImGuiContext* ctx, char* buf, char* buf_end);
+static void             SaveIniSettingsBinary(ImGuiContext* ctx);
+#ifdef IMGUI_ENABLE_ASYNC_INI_SAVING
+static void             DestroySettingsAsyncWriter(ImGuiContext* ctx);
+#endif
+static bool             WindowSettingsHandler_UpdateSettingsFromWindows(ImGuiContext* ctx);
 static void             WindowSettingsHandler_ClearAll(ImGuiContext*, ImGuiSettingsHandler*);
 static void*            WindowSettingsHandler_ReadOpen(ImGuiContext*, ImGuiSettingsHandler*, const char* name);
 static void             WindowSettingsHandler_ReadLine(ImGuiContext*, ImGuiSettingsHandler*, void* entry, const char* line);
 static void             WindowSettingsHandler_ApplyAll(ImGuiContext*, ImGuiSettingsHandler*);
 static void             WindowSettingsHandler_WriteAll(ImGuiContext*, ImGuiSettingsHandler*, ImGuiTextBuffer* buf);
+static void             WindowSettingsHandler_ReadBinary(ImGuiContext*, ImGuiSettingsHandler*, int version, ImGuiSettingsBinaryReader* reader);
+static void             WindowSettingsHandler_WriteBinary(ImGuiContext*, ImGuiSettingsHandler*, ImGuiTextBuffer* buf);
 
 // Platform Dependents default implementation for IO functions
 static const char*      GetClipboardTextFn_DefaultImpl(void* user_data_ctx);
@@ -1217,7 +1236,10 @@ static void             UpdateViewportsNewFrame();
 //   Change to a different context by calling ImGui::SetCurrentContext().
 // - Important: Dear ImGui functions are not thread-safe because of this pointer.
 //   If you want thread-safety to allow N threads to access N different contexts:
-//   - Change this variable to use thread local storage so each thread can refer to a different context, in your imconfig.h:
+//   - Define IMGUI_THREAD_LOCAL_CONTEXT in your imconfig.h: this variable becomes thread-local and each thread refers to its own current context.
+//     Contexts running concurrently must not share an ImFontAtlas (the default is one atlas per context), and ShowDemoWindow() keeps
+//     its state in function statics so it must only be called from one thread. Not supported when building Dear ImGui as a DLL.
+//   - Or change this variable to use your own thread local storage, in your imconfig.h:
 //         struct ImGuiContext;
 //         extern thread_local ImGuiContext* MyImGuiTLS;
 //         #define GImGui MyImGuiTLS
@@ -1226,11 +1248,17 @@ static void             UpdateViewportsNewFrame();
 //   - If you need a finite number of contexts, you may compile and use multiple instances of the ImGui code from a different namespace.
 // - DLL users: read comments above.
 #ifndef GImGui
+#ifdef IMGUI_THREAD_LOCAL_CONTEXT
+thread_local ImGuiContext* GImGui = NULL;
+#else
 ImGuiContext*   GImGui = NULL;
 #endif
+#endif
 
 // Memory Allocator functions. Use SetAllocatorFunctions() to change them.
 // - You probably don't want to modify that mid-program, and if you use global/static e.g. ImVector<> instances you may need to keep them accessible during program destruction.
+// - Each context copies them on creation (or uses the ones passed to CreateContext()), and MemAlloc()/MemFree() use the current context's ones,
+//   so contexts running on different threads can each use their own heap. An ImFontAtlas shared by such contexts should be given its own allocator.
 // - DLL users: read comments above.
 #ifndef IMGUI_DISABLE_DEFAULT_ALLOCATORS
 static void*   MallocWrapper(size_t size, void* user_data)    { IM_UNUSED(user_data); return malloc(size); }
@@ -1242,6 +1270,7 @@ static void    FreeWrapper(void* ptr, void* user_data)        { IM_UNUSED(user_d
 static ImGuiMemAllocFunc    GImAllocatorAllocFunc = MallocWrapper;
 static ImGuiMemFreeFunc     GImAllocatorFreeFunc = FreeWrapper;
 static void*                GImAllocatorUserData = NULL;
+static thread_local ImGuiAllocatorScope* GImAllocatorScope = NULL;   // Innermost ImGuiAllocatorScope of the current thread, takes precedence over the current context's allocator.
 
 //-----------------------------------------------------------------------------
 // [SECTION] USER FACING STRUCTURES (ImGuiStyle, ImGuiIO)
@@ -1354,6 +1383,7 @@ ImGuiIO::ImGuiIO()
     IniSavingRate = 5.0f;
     IniFilename = "imgui.ini"; // Important: "imgui.ini" is relative to current working dir, most apps will want to lock this to an absolute path (e.g. same path as executables).
     LogFilename = "imgui_log.txt";
+    IniSaveBinary = false;
 #ifndef IMGUI_DISABLE_OBSOLETE_KEYIO
     for (int i = 0; i < ImGuiKey_COUNT; i++)
         KeyMap[i] = -1;
@@ -1994,11 +2024,87 @@ const ImWchar* ImStrbolW(const ImWchar* buf_mid_line, const ImWchar* buf_begin)
     return buf_mid_line;
 }
 
+#ifdef IMGUI_ENABLE_SSE
+// Case-fold ASCII letters to upper-case, as ImToUpper() does. Bytes >= 0x80 compare as negative and are left untouched.
+static inline __m128i ImToUpperSSE2(__m128i v)
+{
+    const __m128i is_lower = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8('z' + 1)));
+    return _mm_sub_epi8(v, _mm_and_si128(is_lower, _mm_set1_epi8(0x20)));
+}
+#ifdef __AVX2__
+static inline __m256i ImToUpperAVX2(__m256i v)
+{
+    const __m256i is_lower = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('a' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), v));
+    return _mm256_sub_epi8(v, _mm256_and_si256(is_lower, _mm256_set1_epi8(0x20)));
+}
+#endif
+
+// Verify a candidate whose first and last characters are already known to match
+static inline bool ImStristrMatchMiddle(const char* haystack, const char* needle, size_t needle_len)
+{
+    for (size_t n = 1; n + 1 < needle_len; n++)
+        if (ImToUpper(haystack[n]) != ImToUpper(needle[n]))
+            return false;
+    return true;
+}
+
+// Find candidates 32 (AVX2) or 16 (SSE2) positions at a time by comparing the case-folded first and last characters of the needle,
+// then verify them. Remaining positions near the end of haystack are tested one by one.
+static const char* ImStristrSIMD(const char* haystack, const char* haystack_end, const char* needle, const char* needle_end)
+{
+    const size_t needle_len = (size_t)(needle_end - needle);
+    if ((size_t)(haystack_end - haystack) < needle_len)
+        return NULL;
+    const char* haystack_last = haystack_end - needle_len; // Last possible match position
+    const char un_first = ImToUpper(needle[0]);
+    const char un_last = ImToUpper(needle_end[-1]);
+    const char* p = haystack;
+#ifdef __AVX2__
+    {
+        const __m256i v_first = _mm256_set1_epi8(un_first);
+        const __m256i v_last = _mm256_set1_epi8(un_last);
+        for (; haystack_last - p >= 31; p += 32)
+        {
+            const __m256i block_first = ImToUpperAVX2(_mm256_loadu_si256((const __m256i*)(const void*)p));
+            const __m256i block_last = ImToUpperAVX2(_mm256_loadu_si256((const __m256i*)(const void*)(p + needle_len - 1)));
+            unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(block_first, v_first), _mm256_cmpeq_epi8(block_last, v_last)));
+            for (int bit = 0; mask != 0; bit++, mask >>= 1)
+                if ((mask & 1) && ImStristrMatchMiddle(p + bit, needle, needle_len))
+                    return p + bit;
+        }
+    }
+#endif
+    {
+        const __m128i v_first = _mm_set1_epi8(un_first);
+        const __m128i v_last = _mm_set1_epi8(un_last);
+        for (; haystack_last - p >= 15; p += 16)
+        {
+            const __m128i block_first = ImToUpperSSE2(_mm_loadu_si128((const __m128i*)(const void*)p));
+            const __m128i block_last = ImToUpperSSE2(_mm_loadu_si128((const __m128i*)(const void*)(p + needle_len - 1)));
+            unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(block_first, v_first), _mm_cmpeq_epi8(block_last, v_last)));
+            for (int bit = 0; mask != 0; bit++, mask >>= 1)
+                if ((mask & 1) && ImStristrMatchMiddle(p + bit, needle, needle_len))
+                    return p + bit;
+        }
+    }
+    for (; p <= haystack_last; p++)
+        if (ImToUpper(*p) == un_first && ImToUpper(p[needle_len - 1]) == un_last && ImStristrMatchMiddle(p, needle, needle_len))
+            return p;
+    return NULL;
+}
+#endif // #ifdef IMGUI_ENABLE_SSE
+
+// Case-insensitive (ASCII only) search. Uses SSE2 (and AVX2 if the compiler targets it) unless IMGUI_DISABLE_SSE is defined.
 const char* ImStristr(const char* haystack, const char* haystack_end, const char* needle, const char* needle_end)
 {
     if (!needle_end)
         needle_end = needle + strlen(needle);
 
+#ifdef IMGUI_ENABLE_SSE
+    if (needle_end > needle)
+        return ImStristrSIMD(haystack, haystack_end ? haystack_end : haystack + strlen(haystack), needle, needle_end);
+#endif
+
     const char un0 = (char)ImToUpper(*needle);
     while ((!haystack_end && *haystack) || (haystack_end && haystack < haystack_end))
     {
@@ -2913,6 +3019,84 @@ void ImGuiTextIndex::append(const char* base, int old_size, int new_size)
     EndOffset = ImMax(EndOffset, new_size);
 }
 
+//-----------------------------------------------------------------------------
+// [SECTION] ImFrameArena
+//-----------------------------------------------------------------------------
+
+void* ImFrameArena::Alloc(size_t size, size_t align)
+{
+    IM_ASSERT(align > 0 && (align & (align - 1)) == 0);
+    FrameBytes += size;
+    FrameAllocCount++;
+    if (Blocks.Size > 0)
+    {
+        ImFrameArenaBlock& block = Blocks.back();
+        size_t offset = (size_t)(IM_MEMALIGN((uintptr_t)(block.Data + BlockOffset), (uintptr_t)align) - (uintptr_t)block.Data);
+        if (offset + size <= block.Size)
+        {
+            BlockOffset = offset + size;
+            return block.Data + offset;
+        }
+    }
+
+    // Chain a new block, at least twice as large as the current one
+    ImFrameArenaBlock block;
+    block.Size = ImMax(Blocks.Size > 0 ? Blocks.back().Size * 2 : (size_t)4096, size + align);
+    block.Data = (char*)IM_ALLOC(block.Size);
+    Blocks.push_back(block);
+    BlocksAllocCount++;
+    size_t offset = (size_t)(IM_MEMALIGN((uintptr_t)block.Data, (uintptr_t)align) - (uintptr_t)block.Data);
+    BlockOffset = offset + size;
+    return block.Data + offset;
+}
+
+void ImFrameArena::Reset()
+{
+    LastFrameBytes = FrameBytes;
+    LastFrameAllocCount = FrameAllocCount;
+    HighWaterMark = ImMax(HighWaterMark, FrameBytes);
+    FrameBytes = 0;
+    FrameAllocCount = 0;
+    BlockOffset = 0;
+
+    // Replace chained blocks by a single one which would have fit the whole frame
+    if (Blocks.Size > 1)
+    {
+        size_t capacity = GetCapacity();
+        for (ImFrameArenaBlock& block : Blocks)
+            IM_FREE(block.Data);
+        Blocks.resize(1);
+        Blocks[0].Size = capacity;
+        Blocks[0].Data = (char*)IM_ALLOC(capacity);
+        BlocksAllocCount++;
+    }
+
+    // Give back memory after a spike: every TrimFrames frames, shrink the block if the largest of those frames would have used less than half of it.
+    // Keep some headroom over that frame, as FrameBytes doesn't count alignment padding.
+    RecentPeakBytes = ImMax(RecentPeakBytes, LastFrameBytes);
+    if (++RecentFrames < TrimFrames)
+        return;
+    const size_t trimmed_size = ImMax(RecentPeakBytes + RecentPeakBytes / 2, (size_t)4096);
+    if (Blocks.Size == 1 && Blocks[0].Size > trimmed_size * 2)
+    {
+        IM_FREE(Blocks[0].Data);
+        Blocks[0].Size = trimmed_size;
+        Blocks[0].Data = (char*)IM_ALLOC(trimmed_size);
+        BlocksAllocCount++;
+    }
+    RecentFrames = 0;
+    RecentPeakBytes = 0;
+}
+
+void ImFrameArena::Clear()
+{
+    for (ImFrameArenaBlock& block : Blocks)
+        IM_FREE(block.Data);
+    Blocks.clear();
+    BlockOffset = FrameBytes = RecentPeakBytes = 0;
+    FrameAllocCount = RecentFrames = 0;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImGuiListClipper
 //-----------------------------------------------------------------------------
@@ -3743,9 +3927,20 @@ void ImGui::GetAllocatorFunctions(ImGuiMemAllocFunc* p_alloc_func, ImGuiMemFreeF
 
 ImGuiContext* ImGui::CreateContext(ImFontAtlas* shared_font_atlas)
 {
+    return CreateContext(shared_font_atlas, GImAllocatorAllocFunc, GImAllocatorFreeFunc, GImAllocatorUserData);
+}
+
+ImGuiContext* ImGui::CreateContext(ImFontAtlas* shared_font_atlas, ImGuiMemAllocFunc alloc_func, ImGuiMemFreeFunc free_func, void* user_data)
+{
+    IM_ASSERT(alloc_func != NULL && free_func != NULL);
     ImGuiContext* prev_ctx = GetCurrentContext();
-    ImGuiContext* ctx = IM_NEW(ImGuiContext)(shared_font_atlas);
+    ImGuiContext* ctx = IM_PLACEMENT_NEW((*alloc_func)(sizeof(ImGuiContext), user_data)) ImGuiContext(shared_font_atlas);
+    ctx->AllocatorAllocFunc = alloc_func;
+    ctx->AllocatorFreeFunc = free_func;
+    ctx->AllocatorUserData = user_data;
     SetCurrentContext(ctx);
+    if (ctx->FontAtlasOwnedByContext)
+        ctx->IO.Fonts = IM_NEW(ImFontAtlas)();
     Initialize();
     if (prev_ctx != NULL)
         SetCurrentContext(prev_ctx); // Restore previous context if any, else keep new one.
@@ -3759,8 +3954,13 @@ void ImGui::DestroyContext(ImGuiContext* ctx)
         ctx = prev_ctx;
     SetCurrentContext(ctx);
     Shutdown();
+
+    // Destruct while current so remaining members are freed with the context allocator
+    ImGuiMemFreeFunc free_func = ctx->AllocatorFreeFunc;
+    void* user_data = ctx->AllocatorUserData;
+    ctx->~ImGuiContext();
     SetCurrentContext((prev_ctx != ctx) ? prev_ctx : NULL);
-    IM_DELETE(ctx);
+    (*free_func)(ctx, user_data);
 }
 
 // IMPORTANT: ###xxx suffixes must be same in ALL languages to allow for automation.
@@ -3792,6 +3992,9 @@ void ImGui::Initialize()
         ini_handler.ReadLineFn = WindowSettingsHandler_ReadLine;
         ini_handler.ApplyAllFn = WindowSettingsHandler_ApplyAll;
         ini_handler.WriteAllFn = WindowSettingsHandler_WriteAll;
+        ini_handler.ReadBinaryFn = WindowSettingsHandler_ReadBinary;
+        ini_handler.WriteBinaryFn = WindowSettingsHandler_WriteBinary;
+        ini_handler.BinaryVersion = 1;
         AddSettingsHandler(&ini_handler);
     }
     TableSettingsAddSettingsHandler();
@@ -3849,6 +4052,9 @@ void ImGui::Shutdown()
     // Save settings (unless we haven't attempted to load them: CreateContext/DestroyContext without a call to NewFrame shouldn't save an empty file)
     if (g.SettingsLoaded && g.IO.IniFilename != NULL)
         SaveIniSettingsToDisk(g.IO.IniFilename);
+#ifdef IMGUI_ENABLE_ASYNC_INI_SAVING
+    DestroySettingsAsyncWriter(&g);
+#endif
 
     CallContextHooks(&g, ImGuiContextHookType_Shutdown);
 
@@ -3892,9 +4098,13 @@ void ImGui::Shutdown()
     g.MenusIdSubmittedThisFrame.clear();
     g.InputTextState.ClearFreeMemory();
     g.InputTextDeactivatedState.ClearFreeMemory();
+    g.ColorPickerWheelCache.clear_destruct();
 
     g.SettingsWindows.clear();
+    g.SettingsWindowsMap.Clear();
+    g.SettingsTablesMap.Clear();
     g.SettingsHandlers.clear();
+    g.SettingsHandlerWindow = g.SettingsHandlerTable = NULL;
 
     if (g.LogFile)
     {
@@ -3907,6 +4117,9 @@ void ImGui::Shutdown()
     g.LogBuffer.clear();
     g.DebugLogBuf.clear();
     g.DebugLogIndex.clear();
+#ifdef IMGUI_ENABLE_FRAME_ARENA
+    g.FrameArena.Clear();
+#endif
 
     g.Initialized = false;
 }
@@ -3950,6 +4163,9 @@ void ImGui::CallContextHooks(ImGuiContext* ctx, ImGuiContextHookType hook_type)
 ImGuiWindow::ImGuiWindow(ImGuiContext* ctx, ImStrv name) : DrawListInst(NULL)
 {
     memset(this, 0, sizeof(*this));
+    IDStack.clear(); // Restore inline storage of ImSmallVector<> members
+    DrawListInst._ClipRectStack.clear();
+    DrawListInst._TextureIdStack.clear();
     Ctx = ctx;
     Name = ImStrdup(name);
     NameBufLen = (int)name.length() + 1;
@@ -4394,11 +4610,19 @@ float ImGui::CalcWrapWidthForPos(const ImVec2& pos, float wrap_pos_x)
 }
 
 // IM_ALLOC() == ImGui::MemAlloc()
+// Use the innermost ImGuiAllocatorScope of this thread if any, else the current context's allocator, else the global allocator.
 void* ImGui::MemAlloc(size_t size)
 {
-    void* ptr = (*GImAllocatorAllocFunc)(size, GImAllocatorUserData);
+    ImGuiContext* ctx = GImGui;
+    void* ptr;
+    if (ImGuiAllocatorScope* scope = GImAllocatorScope)
+        ptr = (*scope->AllocFunc)(size, scope->UserData);
+    else if (ctx != NULL && ctx->AllocatorAllocFunc != NULL)
+        ptr = (*ctx->AllocatorAllocFunc)(size, ctx->AllocatorUserData);
+    else
+        ptr = (*GImAllocatorAllocFunc)(size, GImAllocatorUserData);
 #ifndef IMGUI_DISABLE_DEBUG_TOOLS
-    if (ImGuiContext* ctx = GImGui)
+    if (ctx != NULL)
         DebugAllocHook(&ctx->DebugAllocInfo, ctx->FrameCount, ptr, size);
 #endif
     return ptr;
@@ -4407,14 +4631,54 @@ void* ImGui::MemAlloc(size_t size)
 // IM_FREE() == ImGui::MemFree()
 void ImGui::MemFree(void* ptr)
 {
+    ImGuiContext* ctx = GImGui;
 #ifndef IMGUI_DISABLE_DEBUG_TOOLS
-    if (ptr != NULL)
-        if (ImGuiContext* ctx = GImGui)
-            DebugAllocHook(&ctx->DebugAllocInfo, ctx->FrameCount, ptr, (size_t)-1);
+    if (ptr != NULL && ctx != NULL)
+        DebugAllocHook(&ctx->DebugAllocInfo, ctx->FrameCount, ptr, (size_t)-1);
 #endif
+    if (ImGuiAllocatorScope* scope = GImAllocatorScope)
+        return (*scope->FreeFunc)(ptr, scope->UserData);
+    if (ctx != NULL && ctx->AllocatorFreeFunc != NULL)
+        return (*ctx->AllocatorFreeFunc)(ptr, ctx->AllocatorUserData);
     return (*GImAllocatorFreeFunc)(ptr, GImAllocatorUserData);
 }
 
+ImGuiAllocatorScope::ImGuiAllocatorScope(ImGuiMemAllocFunc alloc_func, ImGuiMemFreeFunc free_func, void* user_data)
+{
+    AllocFunc = alloc_func;
+    FreeFunc = free_func;
+    UserData = user_data;
+    Previous = GImAllocatorScope;
+    if (alloc_func != NULL)
+        GImAllocatorScope = this;
+}
+
+ImGuiAllocatorScope::~ImGuiAllocatorScope()
+{
+    if (AllocFunc != NULL)
+        GImAllocatorScope = Previous;
+}
+
+// Transient allocations, for data which doesn't outlive the frame
+void* ImGui::MemAllocTransient(size_t size)
+{
+#ifdef IMGUI_ENABLE_FRAME_ARENA
+    ImGuiContext& g = *GImGui;
+    return g.FrameArena.Alloc(size);
+#else
+    return MemAlloc(size);
+#endif
+}
+
+void ImGui::MemFreeTransient(void* ptr)
+{
+#ifdef IMGUI_ENABLE_FRAME_ARENA
+    IM_UNUSED(ptr);
+#else
+    MemFree(ptr);
+#endif
+}
+
 // We record the number of allocation in recent frames, as a way to audit/sanitize our guiding principles of "no allocations on idle/repeating frames"
 void ImGui::DebugAllocHook(ImGuiDebugAllocInfo* info, int frame_count, void* ptr, size_t size)
 {
@@ -4453,12 +4717,12 @@ void ImGui::SetClipboardText(ImStrv text)
     if (g.IO.SetClipboardTextFn)
     {
         int len = (int)text.length();
-        char* text_p = (char*)IM_ALLOC(len + 1);
+        char* text_p = (char*)MemAllocTransient(len + 1);
         if (len > 0)
             memcpy(text_p, text.Begin, len);
         text_p[len] = 0;        // text may not contain \0, it must be inserted manually.
         g.IO.SetClipboardTextFn(g.IO.ClipboardUserData, text_p);
-        IM_FREE(text_p);
+        MemFreeTransient(text_p);
     }
 }
 
@@ -4473,6 +4737,12 @@ ImGuiIO& ImGui::GetIO()
     return GImGui->IO;
 }
 
+ImGuiIO& ImGui::GetIO(ImGuiContext* ctx)
+{
+    IM_ASSERT(ctx != NULL);
+    return ctx->IO;
+}
+
 // Pass this to your backend rendering function! Valid after Render() and until the next call to NewFrame()
 ImDrawData* ImGui::GetDrawData()
 {
@@ -4786,6 +5056,9 @@ void ImGui::NewFrame()
     g.TooltipOverrideCount = 0;
     g.WindowsActiveCount = 0;
     g.MenusIdSubmittedThisFrame.resize(0);
+#ifdef IMGUI_ENABLE_FRAME_ARENA
+    g.FrameArena.Reset();
+#endif
 
     // Calculate frame-rate for the user, as a purely luxurious feature
     g.FramerateSecPerFrameAccum += g.IO.DeltaTime - g.FramerateSecPerFrame[g.FramerateSecPerFrameIdx];
@@ -5865,8 +6138,12 @@ static ImGuiWindow* CreateNewWindow(ImStrv name, ImGuiWindowFlags flags)
 
     ImGuiWindowSettings* settings = NULL;
     if (!(flags & ImGuiWindowFlags_NoSavedSettings))
+    {
         if ((settings = ImGui::FindWindowSettingsByWindow(window)) != 0)
             window->SettingsOffset = g.SettingsWindows.offset_from_ptr(settings);
+        else if (ImGuiSettingsHandler* handler = g.SettingsHandlerWindow)
+            handler->WantSave = true; // Include in next save (without requesting one)
+    }
 
     InitOrLoadWindowSettings(window, settings);
 
@@ -13873,6 +14150,8 @@ void ImGui::LogButtons()
 // - LoadIniSettingsFromMemory()
 // - SaveIniSettingsToDisk()
 // - SaveIniSettingsToMemory()
+// - LoadIniSettingsText(), LoadIniSettingsBinary(), SaveIniSettingsBinary() [Internal]
+// - SaveIniSettingsToDiskAsync(), FlushIniSettingsToDiskAsync() [Internal]
 //-----------------------------------------------------------------------------
 // - CreateNewWindowSettings() [Internal]
 // - FindWindowSettingsByID() [Internal]
@@ -13901,7 +14180,11 @@ void ImGui::UpdateSettings()
         if (g.SettingsDirtyTimer <= 0.0f)
         {
             if (g.IO.IniFilename != NULL)
+#ifdef IMGUI_ENABLE_ASYNC_INI_SAVING
+                SaveIniSettingsToDiskAsync(g.IO.IniFilename);
+#else
                 SaveIniSettingsToDisk(g.IO.IniFilename);
+#endif
             else
                 g.IO.WantSaveIniSettings = true;  // Let user know they can call SaveIniSettingsToMemory(). user will need to clear io.WantSaveIniSettings themselves.
             g.SettingsDirtyTimer = 0.0f;
@@ -13909,26 +14192,48 @@ void ImGui::UpdateSettings()
     }
 }
 
+// Mark all handlers as needing to be saved. Prefer the more specific versions below when possible.
 void ImGui::MarkIniSettingsDirty()
 {
     ImGuiContext& g = *GImGui;
+    for (ImGuiSettingsHandler& handler : g.SettingsHandlers)
+        handler.WantSave = true;
     if (g.SettingsDirtyTimer <= 0.0f)
         g.SettingsDirtyTimer = g.IO.IniSavingRate;
 }
 
 void ImGui::MarkIniSettingsDirty(ImGuiWindow* window)
 {
-    ImGuiContext& g = *GImGui;
     if (!(window->Flags & ImGuiWindowFlags_NoSavedSettings))
-        if (g.SettingsDirtyTimer <= 0.0f)
-            g.SettingsDirtyTimer = g.IO.IniSavingRate;
+        MarkIniSettingsDirty(GImGui->SettingsHandlerWindow);
+}
+
+void ImGui::MarkIniSettingsDirty(ImGuiSettingsHandler* handler)
+{
+    ImGuiContext& g = *GImGui;
+    if (handler != NULL)
+        handler->WantSave = true;
+    if (g.SettingsDirtyTimer <= 0.0f)
+        g.SettingsDirtyTimer = g.IO.IniSavingRate;
+}
+
+// Built-in handlers are looked up once here rather than each time a window is moved or resized (pointers into SettingsHandlers[] move when it changes)
+static void UpdateSettingsHandlerPointers()
+{
+    ImGuiContext& g = *GImGui;
+    g.SettingsHandlerWindow = ImGui::FindSettingsHandler("Window");
+    g.SettingsHandlerTable = ImGui::FindSettingsHandler("Table");
 }
 
 void ImGui::AddSettingsHandler(const ImGuiSettingsHandler* handler)
 {
     ImGuiContext& g = *GImGui;
     IM_ASSERT(FindSettingsHandler(handler->TypeName) == NULL);
+    IM_ASSERT((handler->ReadBinaryFn != NULL) == (handler->WriteBinaryFn != NULL) && (handler->WriteBinaryFn == NULL || handler->BinaryVersion >= 1));
     g.SettingsHandlers.push_back(*handler);
+    g.SettingsHandlers.back().WantSave = true;
+    g.SettingsHandlers.back().BinaryCacheSize = 0;
+    UpdateSettingsHandlerPointers();
 }
 
 void ImGui::RemoveSettingsHandler(ImStrv type_name)
@@ -13936,6 +14241,7 @@ void ImGui::RemoveSettingsHandler(ImStrv type_name)
     ImGuiContext& g = *GImGui;
     if (ImGuiSettingsHandler* handler = FindSettingsHandler(type_name))
         g.SettingsHandlers.erase(handler);
+    UpdateSettingsHandlerPointers();
 }
 
 ImGuiSettingsHandler* ImGui::FindSettingsHandler(ImStrv type_name)
@@ -13954,8 +14260,12 @@ void ImGui::ClearIniSettings()
     ImGuiContext& g = *GImGui;
     g.SettingsIniData.clear();
     for (ImGuiSettingsHandler& handler : g.SettingsHandlers)
+    {
         if (handler.ClearAllFn != NULL)
             handler.ClearAllFn(&g, &handler);
+        handler.WantSave = true;
+        handler.BinaryCacheSize = 0;
+    }
 }
 
 void ImGui::LoadIniSettingsFromDisk(ImStrv ini_filename)
@@ -13988,10 +14298,37 @@ void ImGui::LoadIniSettingsFromMemory(ImStrv ini_data)
 
     // Call pre-read handlers
     // Some types will clear their data (e.g. dock information) some types will allow merge/override (window)
+    // Loaded data is merged with existing data, so the next save will need to rewrite everything.
     for (ImGuiSettingsHandler& handler : g.SettingsHandlers)
+    {
         if (handler.ReadInitFn != NULL)
             handler.ReadInitFn(&g, &handler);
+        handler.WantSave = true;
+        handler.BinaryCacheSize = 0;
+    }
+
+    if (IsIniSettingsBinary(buf, ini_size))
+        LoadIniSettingsBinary(&g, buf, buf_end);
+    else
+        LoadIniSettingsText(&g, buf, buf_end);
+    g.SettingsLoaded = true;
+
+    // [DEBUG] Restore untouched copy so it can be browsed in Metrics (not strictly necessary)
+    memcpy(buf, ini_data.Begin, ini_size);
 
+    // Call post-read handlers
+    for (ImGuiSettingsHandler& handler : g.SettingsHandlers)
+        if (handler.ApplyAllFn != NULL)
+            handler.ApplyAllFn(&g, &handler);
+}
+
+// Text format:
+//   [Type][Name]
+//   Key=Value (parsed by the handler's ReadLineFn)
+// Writes zero-terminators into 'buf', up to and including 'buf_end[0]' which must be writable.
+static void LoadIniSettingsText(ImGuiContext* ctx, char* buf, char* buf_end)
+{
+    ImGuiContext& g = *ctx;
     void* entry_data = NULL;
     ImGuiSettingsHandler* entry_handler = NULL;
 
@@ -13999,8 +14336,10 @@ void ImGui::LoadIniSettingsFromMemory(ImStrv ini_data)
     for (char* line = buf; line < buf_end; line = line_end + 1)
     {
         // Skip new lines markers, then find end of the line
-        while (*line == '\n' || *line == '\r')
+        while (line < buf_end && (*line == '\n' || *line == '\r'))
             line++;
+        if (line == buf_end)
+            break;
         line_end = line;
         while (line_end < buf_end && *line_end != '\n' && *line_end != '\r')
             line_end++;
@@ -14019,7 +14358,7 @@ void ImGui::LoadIniSettingsFromMemory(ImStrv ini_data)
                 continue;
             *type_end = 0; // Overwrite first ']'
             name_start++;  // Skip second '['
-            entry_handler = FindSettingsHandler(type_start);
+            entry_handler = ImGui::FindSettingsHandler(type_start);
             entry_data = entry_handler ? entry_handler->ReadOpenFn(&g, entry_handler, name_start) : NULL;
         }
         else if (entry_handler != NULL && entry_data != NULL)
@@ -14028,15 +14367,60 @@ void ImGui::LoadIniSettingsFromMemory(ImStrv ini_data)
             entry_handler->ReadLineFn(&g, entry_handler, entry_data, line);
         }
     }
-    g.SettingsLoaded = true;
+}
 
-    // [DEBUG] Restore untouched copy so it can be browsed in Metrics (not strictly necessary)
-    memcpy(buf, ini_data.Begin, ini_size);
+// Binary format (io.IniSaveBinary = true), all values in native endianness:
+//   Header: IMGUI_SETTINGS_BINARY_MAGIC (8 bytes, starting with a zero so it can't be confused with text data), ImU32 format version.
+//   Blocks: ImU32 TypeHash, ImU32 Version, ImU32 Size, followed by 'Size' bytes of data. One block per handler.
+// Handlers providing ReadBinaryFn/WriteBinaryFn write their data in a block of Version == handler->BinaryVersion.
+// Other handlers are stored as a Version 0 block containing their regular text output.
+// Blocks for unknown handlers are skipped, blocks with a newer version than the handler are ignored.
+static const char IMGUI_SETTINGS_BINARY_MAGIC[8] = { 0, 'I', 'M', 'G', 'U', 'I', 'B', 'N' };
+static const ImU32 IMGUI_SETTINGS_BINARY_VERSION = 1;
+static const int IMGUI_SETTINGS_BINARY_HEADER_SIZE = 8 + 4;
+static const int IMGUI_SETTINGS_BINARY_BLOCK_HEADER_SIZE = 4 + 4 + 4;
 
-    // Call post-read handlers
-    for (ImGuiSettingsHandler& handler : g.SettingsHandlers)
-        if (handler.ApplyAllFn != NULL)
-            handler.ApplyAllFn(&g, &handler);
+static bool IsIniSettingsBinary(const char* data, size_t data_size)
+{
+    return data_size >= IMGUI_SETTINGS_BINARY_HEADER_SIZE && memcmp(data, IMGUI_SETTINGS_BINARY_MAGIC, sizeof(IMGUI_SETTINGS_BINARY_MAGIC)) == 0;
+}
+
+static void LoadIniSettingsBinary(ImGuiContext* ctx, char* buf, char* buf_end)
+{
+    ImGuiContext& g = *ctx;
+    ImGuiSettingsBinaryReader reader(buf + sizeof(IMGUI_SETTINGS_BINARY_MAGIC), buf_end);
+    if (reader.Read<ImU32>() != IMGUI_SETTINGS_BINARY_VERSION)
+        return;
+    while (!reader.IsEnd())
+    {
+        const ImGuiID type_hash = reader.Read<ImU32>();
+        const int version = (int)reader.Read<ImU32>();
+        const int block_size = (int)reader.Read<ImU32>();
+        const char* block_data = reader.ReadBytes(block_size);
+        if (block_data == NULL)
+            break;
+
+        ImGuiSettingsHandler* handler = NULL;
+        for (ImGuiSettingsHandler& h : g.SettingsHandlers)
+            if (h.TypeHash == type_hash)
+                handler = &h;
+        if (handler == NULL)
+            continue;
+        if (version == 0)
+        {
+            // Parse a zero-terminated copy, as the text parser writes into its buffer
+            char* text_block = (char*)ImGui::MemAllocTransient((size_t)block_size + 1);
+            memcpy(text_block, block_data, (size_t)block_size);
+            text_block[block_size] = 0;
+            LoadIniSettingsText(&g, text_block, text_block + block_size);
+            ImGui::MemFreeTransient(text_block);
+        }
+        else if (handler->ReadBinaryFn != NULL && version <= handler->BinaryVersion)
+        {
+            ImGuiSettingsBinaryReader block_reader(block_data, block_data + block_size);
+            handler->ReadBinaryFn(&g, handler, version, &block_reader);
+        }
+    }
 }
 
 void ImGui::SaveIniSettingsToDisk(ImStrv ini_filename)
@@ -14045,10 +14429,13 @@ void ImGui::SaveIniSettingsToDisk(ImStrv ini_filename)
     g.SettingsDirtyTimer = 0.0f;
     if (!ini_filename)
         return;
+#ifdef IMGUI_ENABLE_ASYNC_INI_SAVING
+    FlushIniSettingsToDiskAsync(); // Don't let an older background write land after us
+#endif
 
     size_t ini_data_size = 0;
     const char* ini_data = SaveIniSettingsToMemory(&ini_data_size);
-    ImFileHandle f = ImFileOpen(ini_filename, "wt");
+    ImFileHandle f = ImFileOpen(ini_filename, g.IO.IniSaveBinary ? "wb" : "wt");
     if (!f)
         return;
     ImFileWrite(ini_data, sizeof(char), ini_data_size, f);
@@ -14056,19 +14443,224 @@ void ImGui::SaveIniSettingsToDisk(ImStrv ini_filename)
 }
 
 // Call registered handlers (e.g. SettingsHandlerWindow_WriteAll() + custom handlers) to write their stuff into a text buffer
+// When io.IniSaveBinary is set, the output is binary data (use 'out_size', it is not zero-terminated text).
 const char* ImGui::SaveIniSettingsToMemory(size_t* out_size)
 {
     ImGuiContext& g = *GImGui;
     g.SettingsDirtyTimer = 0.0f;
-    g.SettingsIniData.Buf.resize(0);
-    g.SettingsIniData.Buf.push_back(0);
-    for (ImGuiSettingsHandler& handler : g.SettingsHandlers)
-        handler.WriteAllFn(&g, &handler, &g.SettingsIniData);
+    if (g.IO.IniSaveBinary)
+    {
+        SaveIniSettingsBinary(&g);
+    }
+    else
+    {
+        g.SettingsIniData.Buf.resize(0);
+        g.SettingsIniData.Buf.push_back(0);
+        for (ImGuiSettingsHandler& handler : g.SettingsHandlers)
+        {
+            handler.WriteAllFn(&g, &handler, &g.SettingsIniData);
+            handler.BinaryCacheSize = 0;
+        }
+    }
     if (out_size)
         *out_size = (size_t)g.SettingsIniData.size();
     return g.SettingsIniData.c_str();
 }
 
+#ifdef IMGUI_ENABLE_ASYNC_INI_SAVING
+
+// Background .ini writer
+// - The main thread copies serialized settings into Pending*** under the lock. Saves requested before the writer picked up the previous one are coalesced.
+// - The writer thread swaps Pending*** with Write*** and writes to a temporary file which is then renamed over the destination,
+//   so an interrupted write never leaves a truncated .ini file. The temporary file is named after the context, so that contexts saving
+//   to the same file don't write to the same temporary file (the last rename wins).
+// - The writer thread never calls into Dear ImGui (no context access, no MemAlloc()): buffers are allocated and freed on the main thread.
+struct ImGuiSettingsAsyncWriter
+{
+    std::thread             Thread;
+    std::mutex              Mutex;
+    std::condition_variable Cond;               // Signaled when a write is requested or completed, and on shutdown
+    ImVector<char>          PendingData;
+    ImVector<char>          PendingFilename;    // Zero-terminated
+    ImVector<char>          PendingTempFilename;
+    bool                    PendingBinary;
+    bool                    HasPending;
+    bool                    IsWriting;
+    bool                    WantQuit;
+    ImVector<char>          WriteData;          // Owned by the writer thread while IsWriting
+    ImVector<char>          WriteFilename;
+    ImVector<char>          WriteTempFilename;
+    int                     WriteCount;         // Stats displayed in Metrics
+    int                     CoalescedCount;
+    int                     ErrorCount;
+    char                    TempFilenameSuffix[32]; // ".<context address>.tmp"
+
+    ImGuiSettingsAsyncWriter() { PendingBinary = HasPending = IsWriting = WantQuit = false; WriteCount = CoalescedCount = ErrorCount = 0; }
+};
+
+// Write to 'temp_filename' then rename it to 'filename'. Doesn't use ImFileOpen() which may allocate.
+static bool SettingsAsyncWriter_WriteFile(const char* filename, const char* temp_filename, const char* data, size_t data_size, bool binary)
+{
+#if defined(_WIN32) && !defined(IMGUI_DISABLE_WIN32_FUNCTIONS)
+    wchar_t filename_w[FILENAME_MAX];
+    wchar_t temp_filename_w[FILENAME_MAX];
+    if (::MultiByteToWideChar(CP_UTF8, 0, filename, -1, filename_w, FILENAME_MAX) == 0 || ::MultiByteToWideChar(CP_UTF8, 0, temp_filename, -1, temp_filename_w, FILENAME_MAX) == 0)
+        return false;
+    FILE* f = ::_wfopen(temp_filename_w, binary ? L"wb" : L"wt");
+#else
+    FILE* f = fopen(temp_filename, binary ? "wb" : "wt");
+#endif
+    if (f == NULL)
+        return false;
+    bool ok = (fwrite(data, 1, data_size, f) == data_size);
+    ok &= (fclose(f) == 0);
+#if defined(_WIN32) && !defined(IMGUI_DISABLE_WIN32_FUNCTIONS)
+    ok = ok && ::MoveFileExW(temp_filename_w, filename_w, MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    ok = ok && rename(temp_filename, filename) == 0;
+#endif
+    return ok;
+}
+
+static void SettingsAsyncWriter_ThreadMain(ImGuiSettingsAsyncWriter* writer)
+{
+    std::unique_lock<std::mutex> lock(writer->Mutex);
+    while (true)
+    {
+        while (!writer->HasPending && !writer->WantQuit)
+            writer->Cond.wait(lock);
+        if (!writer->HasPending)
+            break; // Quit once everything is written
+
+        writer->WriteData.swap(writer->PendingData);
+        writer->WriteFilename.swap(writer->PendingFilename);
+        writer->WriteTempFilename.swap(writer->PendingTempFilename);
+        const bool binary = writer->PendingBinary;
+        writer->HasPending = false;
+        writer->IsWriting = true;
+        lock.unlock();
+
+        const bool ok = SettingsAsyncWriter_WriteFile(writer->WriteFilename.Data, writer->WriteTempFilename.Data, writer->WriteData.Data, (size_t)writer->WriteData.Size, binary);
+
+        lock.lock();
+        writer->IsWriting = false;
+        writer->WriteCount++;
+        if (!ok)
+            writer->ErrorCount++;
+        writer->Cond.notify_all();
+    }
+}
+
+static void DestroySettingsAsyncWriter(ImGuiContext* ctx)
+{
+    ImGuiContext& g = *ctx;
+    ImGuiSettingsAsyncWriter* writer = g.SettingsAsyncWriter;
+    if (writer == NULL)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(writer->Mutex);
+        writer->WantQuit = true;
+        writer->Cond.notify_all();
+    }
+    writer->Thread.join(); // Finishes pending write
+    IM_DELETE(writer);
+    g.SettingsAsyncWriter = NULL;
+}
+
+void ImGui::SaveIniSettingsToDiskAsync(ImStrv ini_filename)
+{
+    ImGuiContext& g = *GImGui;
+    g.SettingsDirtyTimer = 0.0f;
+    if (!ini_filename)
+        return;
+
+    size_t ini_data_size = 0;
+    const char* ini_data = SaveIniSettingsToMemory(&ini_data_size);
+
+    ImGuiSettingsAsyncWriter* writer = g.SettingsAsyncWriter;
+    if (writer == NULL)
+    {
+        writer = g.SettingsAsyncWriter = IM_NEW(ImGuiSettingsAsyncWriter)();
+        ImFormatString(writer->TempFilenameSuffix, IM_ARRAYSIZE(writer->TempFilenameSuffix), ".%p.tmp", (void*)&g);
+        writer->Thread = std::thread(SettingsAsyncWriter_ThreadMain, writer);
+    }
+
+    // Only copying under the lock: the writer thread doesn't hold it while writing.
+    const int filename_len = (int)ini_filename.length();
+    const int suffix_len = (int)strlen(writer->TempFilenameSuffix);
+    std::lock_guard<std::mutex> lock(writer->Mutex);
+    if (writer->HasPending)
+        writer->CoalescedCount++;
+    writer->PendingData.resize((int)ini_data_size);
+    memcpy(writer->PendingData.Data, ini_data, ini_data_size);
+    writer->PendingFilename.resize(filename_len + 1);
+    memcpy(writer->PendingFilename.Data, ini_filename.Begin, (size_t)filename_len);
+    writer->PendingFilename[filename_len] = 0;
+    writer->PendingTempFilename.resize(filename_len + suffix_len + 1);
+    memcpy(writer->PendingTempFilename.Data, ini_filename.Begin, (size_t)filename_len);
+    memcpy(writer->PendingTempFilename.Data + filename_len, writer->TempFilenameSuffix, (size_t)suffix_len + 1);
+    writer->PendingBinary = g.IO.IniSaveBinary;
+    writer->HasPending = true;
+    writer->Cond.notify_all();
+}
+
+void ImGui::FlushIniSettingsToDiskAsync()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiSettingsAsyncWriter* writer = g.SettingsAsyncWriter;
+    if (writer == NULL)
+        return;
+    std::unique_lock<std::mutex> lock(writer->Mutex);
+    while (writer->HasPending || writer->IsWriting)
+        writer->Cond.wait(lock);
+}
+
+#endif // #ifdef IMGUI_ENABLE_ASYNC_INI_SAVING
+
+// Blocks of handlers which haven't been marked with MarkIniSettingsDirty() since the previous binary save are copied
+// as-is from the previous output, so only the data that changed is encoded again.
+static void SaveIniSettingsBinary(ImGuiContext* ctx)
+{
+    ImGuiContext& g = *ctx;
+    ImGuiTextBuffer* prev_buf = &g.SettingsIniData;
+    ImGuiTextBuffer* buf = &g.SettingsIniDataBinaryTemp;
+    buf->Buf.resize(0);
+    buf->Buf.reserve(prev_buf->Buf.Size);
+    buf->append(IMGUI_SETTINGS_BINARY_MAGIC, IMGUI_SETTINGS_BINARY_MAGIC + sizeof(IMGUI_SETTINGS_BINARY_MAGIC));
+    ImGuiSettingsBinaryWrite(buf, IMGUI_SETTINGS_BINARY_VERSION);
+
+    // Window positions/sizes may change without MarkIniSettingsDirty() (e.g. auto-resizing windows), so compare them before reusing the previous block
+    if (WindowSettingsHandler_UpdateSettingsFromWindows(&g))
+        if (ImGuiSettingsHandler* handler = g.SettingsHandlerWindow)
+            handler->WantSave = true;
+
+    const bool prev_is_binary = IsIniSettingsBinary(prev_buf->c_str(), (size_t)prev_buf->size());
+    for (ImGuiSettingsHandler& handler : g.SettingsHandlers)
+    {
+        const int block_offset = buf->size();
+        if (!handler.WantSave && handler.BinaryCacheSize > 0 && prev_is_binary && handler.BinaryCacheOffset + handler.BinaryCacheSize <= prev_buf->size())
+        {
+            buf->append(prev_buf->c_str() + handler.BinaryCacheOffset, prev_buf->c_str() + handler.BinaryCacheOffset + handler.BinaryCacheSize);
+        }
+        else
+        {
+            ImGuiSettingsBinaryWrite(buf, (ImU32)handler.TypeHash);
+            ImGuiSettingsBinaryWrite(buf, (ImU32)(handler.WriteBinaryFn ? handler.BinaryVersion : 0));
+            ImGuiSettingsBinaryWrite(buf, (ImU32)0); // Patched below
+            if (handler.WriteBinaryFn != NULL)
+                handler.WriteBinaryFn(&g, &handler, buf);
+            else
+                handler.WriteAllFn(&g, &handler, buf);
+            const ImU32 block_size = (ImU32)(buf->size() - block_offset - IMGUI_SETTINGS_BINARY_BLOCK_HEADER_SIZE);
+            memcpy(buf->Buf.Data + block_offset + 8, &block_size, sizeof(block_size));
+        }
+        handler.BinaryCacheOffset = block_offset;
+        handler.BinaryCacheSize = buf->size() - block_offset;
+        handler.WantSave = (handler.WriteBinaryFn == NULL); // We can't tell when text-only handlers change
+    }
+    g.SettingsIniData.Buf.swap(buf->Buf);
+}
+
 ImGuiWindowSettings* ImGui::CreateNewWindowSettings(ImStrv name)
 {
     ImGuiContext& g = *GImGui;
@@ -14095,6 +14687,7 @@ ImGuiWindowSettings* ImGui::CreateNewWindowSettings(ImStrv name)
     settings->ID = ImHashStr(name);
     memcpy(settings->GetName(), name.Begin, name_len);
     settings->GetName()[name_len] = 0;          // name may not contain \0, it must be inserted manually.
+    g.SettingsWindowsMap.SetInt(settings->ID, g.SettingsWindows.offset_from_ptr(settings));
 
     return settings;
 }
@@ -14104,10 +14697,11 @@ ImGuiWindowSettings* ImGui::CreateNewWindowSettings(ImStrv name)
 ImGuiWindowSettings* ImGui::FindWindowSettingsByID(ImGuiID id)
 {
     ImGuiContext& g = *GImGui;
-    for (ImGuiWindowSettings* settings = g.SettingsWindows.begin(); settings != NULL; settings = g.SettingsWindows.next_chunk(settings))
-        if (settings->ID == id && !settings->WantDelete)
-            return settings;
-    return NULL;
+    const int offset = g.SettingsWindowsMap.GetInt(id, 0);
+    if (offset == 0)
+        return NULL;
+    ImGuiWindowSettings* settings = g.SettingsWindows.ptr_from_offset(offset);
+    return (settings->ID == id && !settings->WantDelete) ? settings : NULL;
 }
 
 // This is faster if you are holding on a Window already as we don't need to perform a search.
@@ -14123,6 +14717,7 @@ ImGuiWindowSettings* ImGui::FindWindowSettingsByWindow(ImGuiWindow* window)
 void ImGui::ClearWindowSettings(ImStrv name)
 {
     //IMGUI_DEBUG_LOG("ClearWindowSettings('%s')\n", name);
+    ImGuiContext& g = *GImGui;
     ImGuiWindow* window = FindWindowByName(name);
     if (window != NULL)
     {
@@ -14130,7 +14725,11 @@ void ImGui::ClearWindowSettings(ImStrv name)
         InitOrLoadWindowSettings(window, NULL);
     }
     if (ImGuiWindowSettings* settings = window ? FindWindowSettingsByWindow(window) : FindWindowSettingsByID(ImHashStr(name)))
+    {
         settings->WantDelete = true;
+        if (ImGuiSettingsHandler* handler = g.SettingsHandlerWindow)
+            handler->WantSave = true;
+    }
 }
 
 static void WindowSettingsHandler_ClearAll(ImGuiContext* ctx, ImGuiSettingsHandler*)
@@ -14139,6 +14738,7 @@ static void WindowSettingsHandler_ClearAll(ImGuiContext* ctx, ImGuiSettingsHandl
     for (ImGuiWindow* window : g.Windows)
         window->SettingsOffset = -1;
     g.SettingsWindows.clear();
+    g.SettingsWindowsMap.Clear();
 }
 
 static void* WindowSettingsHandler_ReadOpen(ImGuiContext*, ImGuiSettingsHandler*, const char* name)
@@ -14178,11 +14778,13 @@ static void WindowSettingsHandler_ApplyAll(ImGuiContext* ctx, ImGuiSettingsHandl
         }
 }
 
-static void WindowSettingsHandler_WriteAll(ImGuiContext* ctx, ImGuiSettingsHandler* handler, ImGuiTextBuffer* buf)
+// Gather data from windows that were active during this session
+// (if a window wasn't opened in this session we preserve its settings)
+// Returns true if any settings changed
+static bool WindowSettingsHandler_UpdateSettingsFromWindows(ImGuiContext* ctx)
 {
-    // Gather data from windows that were active during this session
-    // (if a window wasn't opened in this session we preserve its settings)
     ImGuiContext& g = *ctx;
+    bool changed = false;
     for (ImGuiWindow* window : g.Windows)
     {
         if (window->Flags & ImGuiWindowFlags_NoSavedSettings)
@@ -14193,14 +14795,27 @@ static void WindowSettingsHandler_WriteAll(ImGuiContext* ctx, ImGuiSettingsHandl
         {
             settings = ImGui::CreateNewWindowSettings(window->Name);
             window->SettingsOffset = g.SettingsWindows.offset_from_ptr(settings);
+            changed = true;
         }
         IM_ASSERT(settings->ID == window->ID);
-        settings->Pos = ImVec2ih(window->Pos);
-        settings->Size = ImVec2ih(window->SizeFull);
-        settings->IsChild = (window->Flags & ImGuiWindowFlags_ChildWindow) != 0;
+        const ImVec2ih pos(window->Pos);
+        const ImVec2ih size(window->SizeFull);
+        const bool is_child = (window->Flags & ImGuiWindowFlags_ChildWindow) != 0;
+        if (settings->Pos.x != pos.x || settings->Pos.y != pos.y || settings->Size.x != size.x || settings->Size.y != size.y || settings->IsChild != is_child || settings->Collapsed != window->Collapsed || settings->WantDelete)
+            changed = true;
+        settings->Pos = pos;
+        settings->Size = size;
+        settings->IsChild = is_child;
         settings->Collapsed = window->Collapsed;
         settings->WantDelete = false;
     }
+    return changed;
+}
+
+static void WindowSettingsHandler_WriteAll(ImGuiContext* ctx, ImGuiSettingsHandler* handler, ImGuiTextBuffer* buf)
+{
+    ImGuiContext& g = *ctx;
+    WindowSettingsHandler_UpdateSettingsFromWindows(&g);
 
     // Write to text buffer
     buf->reserve(buf->size() + g.SettingsWindows.size() * 6); // ballpark reserve
@@ -14226,6 +14841,55 @@ static void WindowSettingsHandler_WriteAll(ImGuiContext* ctx, ImGuiSettingsHandl
     }
 }
 
+// Binary entry (version 1): ImGuiID ID, ImS16 Pos.x, Pos.y, Size.x, Size.y, ImU8 Flags (1: Collapsed, 2: IsChild), ImU16 NameLen, zero-terminated Name
+static void WindowSettingsHandler_ReadBinary(ImGuiContext* ctx, ImGuiSettingsHandler* handler, int, ImGuiSettingsBinaryReader* reader)
+{
+    while (!reader->IsEnd())
+    {
+        ImGuiWindowSettings tmp;
+        tmp.ID = reader->Read<ImGuiID>();
+        tmp.Pos.x = reader->Read<ImS16>();
+        tmp.Pos.y = reader->Read<ImS16>();
+        tmp.Size.x = reader->Read<ImS16>();
+        tmp.Size.y = reader->Read<ImS16>();
+        const ImU8 flags = reader->Read<ImU8>();
+        const int name_len = reader->Read<ImU16>();
+        const char* name = reader->ReadBytes(name_len + 1);
+        if (reader->Overflow || name[name_len] != 0 || name_len == 0)
+            return;
+
+        ImGuiWindowSettings* settings = (ImGuiWindowSettings*)WindowSettingsHandler_ReadOpen(ctx, handler, name);
+        settings->Pos = tmp.Pos;
+        settings->Size = tmp.Size;
+        settings->Collapsed = (flags & 1) != 0;
+        settings->IsChild = (flags & 2) != 0;
+    }
+}
+
+static void WindowSettingsHandler_WriteBinary(ImGuiContext* ctx, ImGuiSettingsHandler*, ImGuiTextBuffer* buf)
+{
+    ImGuiContext& g = *ctx;
+    WindowSettingsHandler_UpdateSettingsFromWindows(&g);
+
+    buf->reserve(buf->size() + g.SettingsWindows.size()); // Records are smaller than ImGuiWindowSettings chunks
+    for (ImGuiWindowSettings* settings = g.SettingsWindows.begin(); settings != NULL; settings = g.SettingsWindows.next_chunk(settings))
+    {
+        if (settings->WantDelete)
+            continue;
+        const char* settings_name = settings->GetName();
+        const int name_len = ImMin((int)strlen(settings_name), 0xFFFF);
+        ImGuiSettingsBinaryWrite(buf, settings->ID);
+        ImGuiSettingsBinaryWrite(buf, settings->Pos.x);
+        ImGuiSettingsBinaryWrite(buf, settings->Pos.y);
+        ImGuiSettingsBinaryWrite(buf, settings->Size.x);
+        ImGuiSettingsBinaryWrite(buf, settings->Size.y);
+        ImGuiSettingsBinaryWrite(buf, (ImU8)((settings->Collapsed ? 1 : 0) | (settings->IsChild ? 2 : 0)));
+        ImGuiSettingsBinaryWrite(buf, (ImU16)name_len);
+        buf->append(settings_name, settings_name + name_len);
+        ImGuiSettingsBinaryWrite(buf, (char)0);
+    }
+}
+
 
 //-----------------------------------------------------------------------------
 // [SECTION] LOCALIZATION
@@ -14916,9 +15580,9 @@ void ImGui::ShowMetricsWindow(bool* p_open)
         MetricsHelpMarker("You can also call ImGui::DebugTextEncoding() from your code with a given string to test that your UTF-8 encoding settings are correct.");
         if (cfg->ShowTextEncodingViewer)
         {
-            static char buf[64] = "";
+            char* buf = cfg->TextEncodingViewerBuf;
             SetNextItemWidth(-FLT_MIN);
-            InputText("##DebugTextEncodingBuf", buf, IM_ARRAYSIZE(buf));
+            InputText("##DebugTextEncodingBuf", buf, IM_ARRAYSIZE(cfg->TextEncodingViewerBuf));
             if (buf[0] != 0)
                 DebugTextEncoding(buf);
         }
@@ -15073,11 +15737,19 @@ void ImGui::ShowMetricsWindow(bool* p_open)
         else
             TextUnformatted("<NULL>");
         Checkbox("io.ConfigDebugIniSettings", &io.ConfigDebugIniSettings);
+        Checkbox("io.IniSaveBinary", &io.IniSaveBinary);
         Text("SettingsDirtyTimer %.2f", g.SettingsDirtyTimer);
+#ifdef IMGUI_ENABLE_ASYNC_INI_SAVING
+        if (ImGuiSettingsAsyncWriter* writer = g.SettingsAsyncWriter)
+        {
+            std::lock_guard<std::mutex> lock(writer->Mutex);
+            Text("Background writer: %d writes, %d coalesced, %d errors%s", writer->WriteCount, writer->CoalescedCount, writer->ErrorCount, writer->IsWriting ? " (writing)" : "");
+        }
+#endif
         if (TreeNode("SettingsHandlers", "Settings handlers: (%d)", g.SettingsHandlers.Size))
         {
             for (ImGuiSettingsHandler& handler : g.SettingsHandlers)
-                BulletText("\"%s\"", handler.TypeName);
+                BulletText("\"%s\": binary v%d, %s, last binary block: %d bytes", handler.TypeName, handler.WriteBinaryFn ? handler.BinaryVersion : 0, handler.WantSave ? "dirty" : "clean", handler.BinaryCacheSize);
             TreePop();
         }
         if (TreeNode("SettingsWindows", "Settings packed data: Windows: %d bytes", g.SettingsWindows.size()))
@@ -15099,7 +15771,10 @@ void ImGui::ShowMetricsWindow(bool* p_open)
 
         if (TreeNode("SettingsIniData", "Settings unpacked data (.ini): %d bytes", g.SettingsIniData.size()))
         {
-            InputTextMultiline("##Ini", (char*)(void*)g.SettingsIniData.c_str(), g.SettingsIniData.Buf.Size, ImVec2(-FLT_MIN, GetTextLineHeight() * 20), ImGuiInputTextFlags_ReadOnly);
+            if (IsIniSettingsBinary(g.SettingsIniData.c_str(), (size_t)g.SettingsIniData.size()))
+                TextUnformatted("(binary data)");
+            else
+                InputTextMultiline("##Ini", (char*)(void*)g.SettingsIniData.c_str(), g.SettingsIniData.Buf.Size, ImVec2(-FLT_MIN, GetTextLineHeight() * 20), ImGuiInputTextFlags_ReadOnly);
             TreePop();
         }
         TreePop();
@@ -15111,6 +15786,22 @@ void ImGui::ShowMetricsWindow(bool* p_open)
         ImGuiDebugAllocInfo* info = &g.DebugAllocInfo;
         Text("%d current allocations", info->TotalAllocCount - info->TotalFreeCount);
         if (SmallButton("GC now")) { g.GcCompactAll = true; }
+#ifdef IMGUI_ENABLE_FRAME_ARENA
+        ImFrameArena* arena = &g.FrameArena;
+        Text("Frame arena: %d blocks, %d KB capacity, %d block allocations", arena->Blocks.Size, (int)(arena->GetCapacity() / 1024), arena->BlocksAllocCount);
+        BulletText("Last frame: %d bytes in %d allocations", (int)arena->LastFrameBytes, arena->LastFrameAllocCount);
+        BulletText("High-water mark: %d bytes", (int)arena->HighWaterMark);
+        BulletText("Largest frame in the last %d frames: %d bytes (trimmed every %d frames)", arena->RecentFrames, (int)arena->RecentPeakBytes, arena->TrimFrames);
+#endif
+        int stacks_total = 0, stacks_inline = 0;
+        for (ImGuiWindow* window : g.Windows)
+        {
+            stacks_total += 3;
+            stacks_inline += (window->IDStack.is_inline() ? 1 : 0) + (window->DrawList->_ClipRectStack.is_inline() ? 1 : 0) + (window->DrawList->_TextureIdStack.is_inline() ? 1 : 0);
+        }
+        stacks_total += 5;
+        stacks_inline += (g.ColorStack.is_inline() ? 1 : 0) + (g.StyleVarStack.is_inline() ? 1 : 0) + (g.FontStack.is_inline() ? 1 : 0) + (g.ItemFlagsStack.is_inline() ? 1 : 0) + (g.GroupStack.is_inline() ? 1 : 0);
+        Text("Small stacks: %d/%d using inline storage (others spilled to heap)", stacks_inline, stacks_total);
         Text("Recent frames with allocations:");
         int buf_size = IM_ARRAYSIZE(info->LastEntriesBuf);
         for (int n = buf_size - 1; n >= 0; n--)
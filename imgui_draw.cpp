@@ -2399,12 +2399,14 @@ ImFontAtlas::ImFontAtlas()
 ImFontAtlas::~ImFontAtlas()
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    ImGuiAllocatorScope allocator_scope(AllocatorAllocFunc, AllocatorFreeFunc, AllocatorUserData);
     Clear();
 }
 
 void    ImFontAtlas::ClearInputData()
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    ImGuiAllocatorScope allocator_scope(AllocatorAllocFunc, AllocatorFreeFunc, AllocatorUserData);
     for (ImFontConfig& font_cfg : ConfigData)
         if (font_cfg.FontData && font_cfg.FontDataOwnedByAtlas)
         {
@@ -2428,6 +2430,7 @@ void    ImFontAtlas::ClearInputData()
 void    ImFontAtlas::ClearTexData()
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    ImGuiAllocatorScope allocator_scope(AllocatorAllocFunc, AllocatorFreeFunc, AllocatorUserData);
     if (TexPixelsAlpha8)
         IM_FREE(TexPixelsAlpha8);
     if (TexPixelsRGBA32)
@@ -2441,6 +2444,7 @@ void    ImFontAtlas::ClearTexData()
 void    ImFontAtlas::ClearFonts()
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    ImGuiAllocatorScope allocator_scope(AllocatorAllocFunc, AllocatorFreeFunc, AllocatorUserData);
     Fonts.clear_delete();
     TexReady = false;
 }
@@ -2452,6 +2456,15 @@ void    ImFontAtlas::Clear()
     ClearFonts();
 }
 
+void    ImFontAtlas::SetAllocatorFunctions(ImGuiMemAllocFunc alloc_func, ImGuiMemFreeFunc free_func, void* user_data)
+{
+    IM_ASSERT(Fonts.Size == 0 && ConfigData.Size == 0 && CustomRects.Size == 0 && TexPixelsAlpha8 == NULL && TexPixelsRGBA32 == NULL && "Call before adding fonts!");
+    IM_ASSERT((alloc_func != NULL) == (free_func != NULL));
+    AllocatorAllocFunc = alloc_func;
+    AllocatorFreeFunc = free_func;
+    AllocatorUserData = user_data;
+}
+
 void    ImFontAtlas::GetTexDataAsAlpha8(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel)
 {
     // Build atlas on demand
@@ -2466,6 +2479,7 @@ void    ImFontAtlas::GetTexDataAsAlpha8(unsigned char** out_pixels, int* out_wid
 
 void    ImFontAtlas::GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel)
 {
+    ImGuiAllocatorScope allocator_scope(AllocatorAllocFunc, AllocatorFreeFunc, AllocatorUserData);
     // Convert to RGBA32 format on demand
     // Although it is likely to be the most commonly used format, our font rendering is 1 channel / 8 bpp
     if (!TexPixelsRGBA32)
@@ -2491,6 +2505,7 @@ void    ImFontAtlas::GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_wid
 ImFont* ImFontAtlas::AddFont(const ImFontConfig* font_cfg)
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    ImGuiAllocatorScope allocator_scope(AllocatorAllocFunc, AllocatorFreeFunc, AllocatorUserData);
     IM_ASSERT(font_cfg->FontData != NULL && font_cfg->FontDataSize > 0);
     IM_ASSERT(font_cfg->SizePixels > 0.0f);
 
@@ -2565,6 +2580,7 @@ ImFont* ImFontAtlas::AddFontDefault(const ImFontConfig* font_cfg_template)
 ImFont* ImFontAtlas::AddFontFromFileTTF(ImStrv filename, float size_pixels, const ImFontConfig* font_cfg_template, const ImWchar* glyph_ranges)
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    ImGuiAllocatorScope allocator_scope(AllocatorAllocFunc, AllocatorFreeFunc, AllocatorUserData);
     size_t data_size = 0;
     void* data = ImFileLoadToMemory(filename, "rb", &data_size, 0);
     if (!data)
@@ -2601,6 +2617,7 @@ ImFont* ImFontAtlas::AddFontFromMemoryTTF(void* font_data, int font_data_size, f
 
 ImFont* ImFontAtlas::AddFontFromMemoryCompressedTTF(const void* compressed_ttf_data, int compressed_ttf_size, float size_pixels, const ImFontConfig* font_cfg_template, const ImWchar* glyph_ranges)
 {
+    ImGuiAllocatorScope allocator_scope(AllocatorAllocFunc, AllocatorFreeFunc, AllocatorUserData);
     const unsigned int buf_decompressed_size = stb_decompress_length((const unsigned char*)compressed_ttf_data);
     unsigned char* buf_decompressed_data = (unsigned char*)IM_ALLOC(buf_decompressed_size);
     stb_decompress(buf_decompressed_data, (const unsigned char*)compressed_ttf_data, (unsigned int)compressed_ttf_size);
@@ -2613,6 +2630,7 @@ ImFont* ImFontAtlas::AddFontFromMemoryCompressedTTF(const void* compressed_ttf_d
 
 ImFont* ImFontAtlas::AddFontFromMemoryCompressedBase85TTF(ImStrv compressed_ttf_data_base85, float size_pixels, const ImFontConfig* font_cfg, const ImWchar* glyph_ranges)
 {
+    ImGuiAllocatorScope allocator_scope(AllocatorAllocFunc, AllocatorFreeFunc, AllocatorUserData);
     int compressed_ttf_size = (((int)compressed_ttf_data_base85.length() + 4) / 5) * 4;
     void* compressed_ttf = IM_ALLOC((size_t)compressed_ttf_size);
     Decode85(compressed_ttf_data_base85, (unsigned char*)compressed_ttf);
@@ -2623,6 +2641,7 @@ ImFont* ImFontAtlas::AddFontFromMemoryCompressedBase85TTF(ImStrv compressed_ttf_
 
 int ImFontAtlas::AddCustomRectRegular(int width, int height)
 {
+    ImGuiAllocatorScope allocator_scope(AllocatorAllocFunc, AllocatorFreeFunc, AllocatorUserData);
     IM_ASSERT(width > 0 && width <= 0xFFFF);
     IM_ASSERT(height > 0 && height <= 0xFFFF);
     ImFontAtlasCustomRect r;
@@ -2634,6 +2653,7 @@ int ImFontAtlas::AddCustomRectRegular(int width, int height)
 
 int ImFontAtlas::AddCustomRectFontGlyph(ImFont* font, ImWchar id, int width, int height, float advance_x, const ImVec2& offset)
 {
+    ImGuiAllocatorScope allocator_scope(AllocatorAllocFunc, AllocatorFreeFunc, AllocatorUserData);
 #ifdef IMGUI_USE_WCHAR32
     IM_ASSERT(id <= IM_UNICODE_CODEPOINT_MAX);
 #endif
@@ -2683,6 +2703,7 @@ bool ImFontAtlas::GetMouseCursorTexData(ImGuiMouseCursor cursor_type, ImVec2* ou
 bool    ImFontAtlas::Build()
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    ImGuiAllocatorScope allocator_scope(AllocatorAllocFunc, AllocatorFreeFunc, AllocatorUserData);
 
     // Default font is none are specified
     if (ConfigData.Size == 0)
@@ -3031,8 +3052,7 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
 
 const ImFontBuilderIO* ImFontAtlasGetBuilderForStbTruetype()
 {
-    static ImFontBuilderIO io;
-    io.FontBuilder_Build = ImFontAtlasBuildWithStbTruetype;
+    static const ImFontBuilderIO io = { ImFontAtlasBuildWithStbTruetype };
     return &io;
 }
 
@@ -3262,6 +3282,7 @@ void ImFontAtlasBuildFinish(ImFontAtlas* atlas)
             font->BuildLookupTable();
 
     atlas->TexReady = true;
+    atlas->TexBuildCount++;
 }
 
 // Retrieve list of range (2 int per range, values are inclusive)
@@ -3325,6 +3346,14 @@ static void UnpackAccumulativeOffsetsIntoRanges(int base_codepoint, const short*
     out_ranges[0] = 0;
 }
 
+// Copy base ranges then unpack ranges from 0x4E00. Returns true so it can be used to initialize a function-local static.
+static bool UnpackGlyphRanges(ImWchar* out_ranges, const ImWchar* base_ranges, int base_ranges_count, const short* accumulative_offsets_from_0x4E00, int accumulative_offsets_count)
+{
+    memcpy(out_ranges, base_ranges, sizeof(ImWchar) * base_ranges_count);
+    UnpackAccumulativeOffsetsIntoRanges(0x4E00, accumulative_offsets_from_0x4E00, accumulative_offsets_count, out_ranges + base_ranges_count);
+    return true;
+}
+
 //-------------------------------------------------------------------------
 // [SECTION] ImFontAtlas glyph ranges helpers
 //-------------------------------------------------------------------------
@@ -3389,11 +3418,8 @@ const ImWchar*  ImFontAtlas::GetGlyphRangesChineseSimplifiedCommon()
         0xFFFD, 0xFFFD  // Invalid
     };
     static ImWchar full_ranges[IM_ARRAYSIZE(base_ranges) + IM_ARRAYSIZE(accumulative_offsets_from_0x4E00) * 2 + 1] = { 0 };
-    if (!full_ranges[0])
-    {
-        memcpy(full_ranges, base_ranges, sizeof(base_ranges));
-        UnpackAccumulativeOffsetsIntoRanges(0x4E00, accumulative_offsets_from_0x4E00, IM_ARRAYSIZE(accumulative_offsets_from_0x4E00), full_ranges + IM_ARRAYSIZE(base_ranges));
-    }
+    static const bool full_ranges_unpacked = UnpackGlyphRanges(full_ranges, base_ranges, IM_ARRAYSIZE(base_ranges), accumulative_offsets_from_0x4E00, IM_ARRAYSIZE(accumulative_offsets_from_0x4E00)); // Thread-safe static initialization
+    IM_UNUSED(full_ranges_unpacked);
     return &full_ranges[0];
 }
 
@@ -3479,11 +3505,8 @@ const ImWchar*  ImFontAtlas::GetGlyphRangesJapanese()
         0xFFFD, 0xFFFD  // Invalid
     };
     static ImWchar full_ranges[IM_ARRAYSIZE(base_ranges) + IM_ARRAYSIZE(accumulative_offsets_from_0x4E00)*2 + 1] = { 0 };
-    if (!full_ranges[0])
-    {
-        memcpy(full_ranges, base_ranges, sizeof(base_ranges));
-        UnpackAccumulativeOffsetsIntoRanges(0x4E00, accumulative_offsets_from_0x4E00, IM_ARRAYSIZE(accumulative_offsets_from_0x4E00), full_ranges + IM_ARRAYSIZE(base_ranges));
-    }
+    static const bool full_ranges_unpacked = UnpackGlyphRanges(full_ranges, base_ranges, IM_ARRAYSIZE(base_ranges), accumulative_offsets_from_0x4E00, IM_ARRAYSIZE(accumulative_offsets_from_0x4E00)); // Thread-safe static initialization
+    IM_UNUSED(full_ranges_unpacked);
     return &full_ranges[0];
 }
 
@@ -3779,6 +3802,7 @@ void ImFont::AddGlyph(const ImFontConfig* cfg, ImWchar codepoint, float x0, floa
 void ImFont::AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst)
 {
     IM_ASSERT(IndexLookup.Size > 0);    // Currently this can only be called AFTER the font has been built, aka after calling ImFontAtlas::GetTexDataAs*() function.
+    ImGuiAllocatorScope allocator_scope(ContainerAtlas->AllocatorAllocFunc, ContainerAtlas->AllocatorFreeFunc, ContainerAtlas->AllocatorUserData);
     unsigned int index_size = (unsigned int)IndexLookup.Size;
 
     if (dst < index_size && IndexLookup.Data[dst] == (ImWchar)-1 && !overwrite_dst) // 'dst' already exists
@@ -4424,9 +4448,10 @@ static unsigned int stb_decompress_length(const unsigned char *input)
     return (input[8] << 24) + (input[9] << 16) + (input[10] << 8) + input[11];
 }
 
-static unsigned char *stb__barrier_out_e, *stb__barrier_out_b;
-static const unsigned char *stb__barrier_in_b;
-static unsigned char *stb__dout;
+// Decompressor state is thread-local so atlases of different contexts can be built concurrently
+static thread_local unsigned char *stb__barrier_out_e, *stb__barrier_out_b;
+static thread_local const unsigned char *stb__barrier_in_b;
+static thread_local unsigned char *stb__dout;
 static void stb__match(const unsigned char *data, unsigned int length)
 {
     // INVERSE of memmove... write each byte before copying the next...
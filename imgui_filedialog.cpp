@@ -11,6 +11,21 @@
 #include <sstream>
 #include <algorithm>
 #include <cstring>
+#include <mutex>
+#include <thread>
+#include <format>
+#include <condition_variable>
+#include <unordered_map>
+#include <unordered_set>
+#include <deque>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
 
 #include "imgui_modern.h"
 #include "imgui_filedialog.h"
@@ -18,313 +33,688 @@
 using namespace std::chrono_literals;
 namespace ig = ghassanpl::ig;
 
-typedef int ImGuiFileDialogSortOrder;
-
-enum ImGuiFileDialogSortOrder_
-{
-	ImGuiFileDialogSortOrder_Up,
-	ImGuiFileDialogSortOrder_Down,
-	ImGuiFileDialogSortOrder_None
-};
-
-void ImFileDialogInfo::refreshPaths()
+// Gathers what the dialog displays/sorts by, so that neither sorting nor drawing touch the filesystem.
+// The displayed strings are formatted here too: the dialog only draws the visible rows, but it should not format them every frame.
+struct ImFileDialogEntryStat
 {
-	refreshInfo = false;
-	currentIndex = 0;
-	currentFiles.clear();
-	currentDirectories.clear();
+	std::filesystem::file_time_type fileNow = std::filesystem::file_time_type::clock::now();
+	std::chrono::system_clock::time_point systemNow = std::chrono::system_clock::now();
 
-	if (!std::filesystem::exists(directoryPath))
-		directoryPath = std::filesystem::current_path();
-
-	for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(directoryPath))
+	bool stat(ImFileDialogEntry& e, std::filesystem::directory_entry const& entry) const
 	{
-		if (entry.is_directory())
-		{
-			currentDirectories.push_back(entry);
-		}
-		else
+		std::error_code ec;
+		e.entry = entry;
+		e.isDirectory = e.entry.is_directory(ec);
+		if (ec)
+			return false;
+		e.name = e.entry.path().filename().string();
+		e.lastWriteTime = e.entry.last_write_time(ec);
+		if (!e.isDirectory)
 		{
-			if (fileFilterFunc != nullptr) {
-				if (!fileFilterFunc(entry)) {
-					continue;
-				}
-			}
-			currentFiles.push_back(entry);
+			e.extension = e.entry.path().extension().string();
+			e.size = e.entry.file_size(ec);
+			if (ec)
+				e.size = 0;
+			e.sizeText = std::to_string(e.size);
 		}
+		const auto st = std::chrono::time_point_cast<std::chrono::system_clock::duration>(e.lastWriteTime - fileNow + systemNow);
+		e.dateText = std::format("{0:%F} {0:%R}", st);
+		return true;
 	}
-}
+};
 
-bool ImGui::FileDialog(bool* open, ImFileDialogInfo* dialogInfo)
+// Enumerates a directory on a background thread, then (optionally) keeps watching it and reports changes as deltas:
+// - Linux: inotify on the directory.
+// - Elsewhere, or if inotify is unavailable: the directory is enumerated again periodically and compared to the previous listing.
+struct ImFileDialogScan
 {
-	if (!*open) return false;
-
-	static float initialSpacingColumn0 = 230.0f;
-	static float initialSpacingColumn1 = 80.0f;
-	static float initialSpacingColumn2 = 90.0f;
-	static float initialSpacingColumn3 = 150.0f;
-	static ImGuiFileDialogSortOrder fileNameSortOrder = ImGuiFileDialogSortOrder_None;
-	static ImGuiFileDialogSortOrder sizeSortOrder = ImGuiFileDialogSortOrder_None;
-	static ImGuiFileDialogSortOrder dateSortOrder = ImGuiFileDialogSortOrder_None;
-	static ImGuiFileDialogSortOrder typeSortOrder = ImGuiFileDialogSortOrder_None;
-
-	assert(dialogInfo != nullptr);
-
-	bool complete = false;
-
-	ImGui::PushID(dialogInfo);
-	ImGui::SetNextWindowSize(ImVec2(740.0f, 410.0f), ImGuiCond_FirstUseEver);
-
-	if (ImGui::Begin(dialogInfo->title.c_str(), open))
+	static constexpr size_t BatchSize = 256;
+	static constexpr auto PublishInterval = 100ms;	// Changes are coalesced for this long before being handed to the dialog
+	static constexpr auto PollInterval = 1s;		// Polling fallback: directory timestamp check
+	static constexpr int PollFullEvery = 5;			// Polling fallback: compare the whole listing every N checks even if the directory timestamp is unchanged, to catch modified files
+
+	std::mutex mutex;
+	std::vector<ImFileDialogEntry> pending;	// Entries found by the initial enumeration since the last pollScan(), protected by mutex
+	std::vector<ImFileDialogEntry> changed;	// Entries added or modified while watching, protected by mutex
+	std::vector<std::string> removed;		// Names of entries removed while watching, protected by mutex
+	bool done = false;						// Initial enumeration finished, protected by mutex
+	bool invalidated = false;				// The watched directory is gone or changes were lost: scan again. Protected by mutex
+	std::jthread thread;					// Declared last: destroyed (stopped and joined) first
+
+	using Snapshot = std::unordered_map<std::string, std::pair<std::filesystem::file_time_type, std::uintmax_t>>;
+
+	void run(std::stop_token stop, std::filesystem::path directory, bool watch)
 	{
-		if ((dialogInfo->currentFiles.empty() && dialogInfo->currentDirectories.empty()) || dialogInfo->refreshInfo)
-			dialogInfo->refreshPaths();
-
-		// Draw path
-		ImGui::Text("Path: %s", dialogInfo->directoryPath.string().c_str());
-
-		auto content_region = ig::GetWindowContentRegion();
-		auto bottom_h = GetFrameHeightWithSpacing() * 3;
-
-		ImGui::BeginChild("##browser", ImVec2(content_region.GetWidth(), content_region.GetHeight() - bottom_h), true, ImGuiWindowFlags_HorizontalScrollbar);
-		ImGui::Columns(5);
-
-		// Columns size
-		if (initialSpacingColumn0 > 0)
-		{
-			ImGui::SetColumnWidth(0, initialSpacingColumn0);
-			initialSpacingColumn0 = 0.0f;
-		}
-		if (initialSpacingColumn1 > 0)
-		{
-			ImGui::SetColumnWidth(1, initialSpacingColumn1);
-			initialSpacingColumn1 = 0.0f;
-		}
-		if (initialSpacingColumn2 > 0)
-		{
-			ImGui::SetColumnWidth(2, initialSpacingColumn2);
-			initialSpacingColumn2 = 0.0f;
-		}
-		if (initialSpacingColumn3 > 0)
+#if defined(__linux__)
+		// Watch before enumerating so that nothing changing during enumeration is missed
+		int watch_fd = watch ? inotify_init1(IN_NONBLOCK | IN_CLOEXEC) : -1;
+		if (watch_fd >= 0 && inotify_add_watch(watch_fd, directory.c_str(), IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR) < 0)
 		{
-			ImGui::SetColumnWidth(3, initialSpacingColumn3);
-			initialSpacingColumn3 = 0.0f;
+			close(watch_fd);
+			watch_fd = -1;
 		}
+#endif
+
+		Snapshot snapshot;
+		bool listed = enumerate(stop, directory, watch ? &snapshot : nullptr);
 
-		// File Columns
-		if (ImGui::Selectable("Name"))
 		{
-			sizeSortOrder = ImGuiFileDialogSortOrder_None;
-			dateSortOrder = ImGuiFileDialogSortOrder_None;
-			typeSortOrder = ImGuiFileDialogSortOrder_None;
-			fileNameSortOrder = fileNameSortOrder == ImGuiFileDialogSortOrder_Down ? ImGuiFileDialogSortOrder_Up : ImGuiFileDialogSortOrder_Down;
+			std::lock_guard lock{ mutex };
+			done = true;
 		}
-		ImGui::NextColumn();
-		if (ImGui::Selectable("Size"))
+
+#if defined(__linux__)
+		if (watch_fd >= 0)
 		{
-			fileNameSortOrder = ImGuiFileDialogSortOrder_None;
-			dateSortOrder = ImGuiFileDialogSortOrder_None;
-			typeSortOrder = ImGuiFileDialogSortOrder_None;
-			sizeSortOrder = sizeSortOrder == ImGuiFileDialogSortOrder_Down ? ImGuiFileDialogSortOrder_Up : ImGuiFileDialogSortOrder_Down;
+			if (listed)
+				watchInotify(stop, directory, watch_fd);
+			close(watch_fd);
+			return;
 		}
-		ImGui::NextColumn();
-		if (ImGui::Selectable("Type"))
+#endif
+		if (listed && watch)
+			watchPolling(stop, directory, std::move(snapshot));
+	}
+
+	bool enumerate(std::stop_token const& stop, std::filesystem::path const& directory, Snapshot* snapshot)
+	{
+		ImFileDialogEntryStat stat;
+		std::vector<ImFileDialogEntry> batch;
+		batch.reserve(BatchSize);
+		std::error_code ec;
+		std::filesystem::directory_iterator it(directory, std::filesystem::directory_options::skip_permission_denied, ec);
+		if (ec)
+			return false;
+		for (std::filesystem::directory_iterator end; !ec && it != end && !stop.stop_requested(); it.increment(ec))
 		{
-			fileNameSortOrder = ImGuiFileDialogSortOrder_None;
-			dateSortOrder = ImGuiFileDialogSortOrder_None;
-			sizeSortOrder = ImGuiFileDialogSortOrder_None;
-			typeSortOrder = typeSortOrder == ImGuiFileDialogSortOrder_Down ? ImGuiFileDialogSortOrder_Up : ImGuiFileDialogSortOrder_Down;
+			ImFileDialogEntry& e = batch.emplace_back();
+			if (!stat.stat(e, *it))
+			{
+				batch.pop_back();
+				continue;
+			}
+			if (snapshot)
+				snapshot->emplace(e.name, std::pair{ e.lastWriteTime, e.size });
+
+			if (batch.size() == BatchSize)
+			{
+				std::lock_guard lock{ mutex };
+				pending.insert(pending.end(), std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+				batch.clear();
+			}
 		}
-		ImGui::NextColumn();
-		if (ImGui::Selectable("Date"))
+
+		std::lock_guard lock{ mutex };
+		pending.insert(pending.end(), std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+		return !ec;
+	}
+
+	// Hands the entries named in 'names' to the dialog: stat'ed again if they still exist, removed otherwise
+	void publish(std::filesystem::path const& directory, std::unordered_set<std::string>& names)
+	{
+		ImFileDialogEntryStat stat;
+		std::vector<ImFileDialogEntry> found;
+		std::vector<std::string> gone;
+		for (auto& name : names)
 		{
-			fileNameSortOrder = ImGuiFileDialogSortOrder_None;
-			sizeSortOrder = ImGuiFileDialogSortOrder_None;
-			typeSortOrder = ImGuiFileDialogSortOrder_None;
-			dateSortOrder = dateSortOrder == ImGuiFileDialogSortOrder_Down ? ImGuiFileDialogSortOrder_Up : ImGuiFileDialogSortOrder_Down;
+			std::error_code ec;
+			std::filesystem::directory_entry entry{ directory / name, ec };
+			ImFileDialogEntry& e = found.emplace_back();
+			if (ec || !entry.exists(ec) || !stat.stat(e, entry))
+			{
+				found.pop_back();
+				gone.push_back(name);
+			}
 		}
-		ImGui::NextColumn();
-		ImGui::Text("Actions");
-		ImGui::NextColumn();
+		names.clear();
 
-		// File Separator
-		ImGui::Separator();
+		std::lock_guard lock{ mutex };
+		changed.insert(changed.end(), std::make_move_iterator(found.begin()), std::make_move_iterator(found.end()));
+		removed.insert(removed.end(), std::make_move_iterator(gone.begin()), std::make_move_iterator(gone.end()));
+	}
 
-		// Sort directories
-		auto& directories = dialogInfo->currentDirectories;
+	void invalidate()
+	{
+		std::lock_guard lock{ mutex };
+		invalidated = true;
+	}
 
-		if (fileNameSortOrder != ImGuiFileDialogSortOrder_None || sizeSortOrder != ImGuiFileDialogSortOrder_None || typeSortOrder != ImGuiFileDialogSortOrder_None)
+#if defined(__linux__)
+	void watchInotify(std::stop_token const& stop, std::filesystem::path const& directory, int watch_fd)
+	{
+		// Stopping the thread wakes poll() up through an eventfd
+		const int wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		if (wake_fd < 0)
+			return invalidate();
 		{
-			std::sort(directories.begin(), directories.end(), [](const std::filesystem::directory_entry& a, const std::filesystem::directory_entry& b)
+			std::stop_callback wake{ stop, [wake_fd] { const uint64_t one = 1; (void)!write(wake_fd, &one, sizeof(one)); } };
+
+			std::unordered_set<std::string> names;
+			auto last_publish = std::chrono::steady_clock::now();
+			alignas(inotify_event) char buffer[16 * 1024];
+			while (!stop.stop_requested())
 			{
-				if (fileNameSortOrder == ImGuiFileDialogSortOrder_Down)
+				// Wait for events; once some are collected, only until they are due to be published
+				int timeout = -1;
+				if (!names.empty())
+					timeout = (int)std::max<std::chrono::milliseconds::rep>(0, std::chrono::duration_cast<std::chrono::milliseconds>(last_publish + PublishInterval - std::chrono::steady_clock::now()).count());
+				pollfd fds[2] = { { watch_fd, POLLIN, 0 }, { wake_fd, POLLIN, 0 } };
+				if (poll(fds, 2, timeout) < 0 && errno != EINTR)
 				{
-					return a.path().filename() > b.path().filename();
+					invalidate();
+					break;
 				}
 
-				return a.path().filename() < b.path().filename();
-			});
-		}
-		else if (dateSortOrder != ImGuiFileDialogSortOrder_None)
-		{
-			std::sort(directories.begin(), directories.end(), [](const std::filesystem::directory_entry& a, const std::filesystem::directory_entry& b)
-			{
-				if (dateSortOrder == ImGuiFileDialogSortOrder_Down)
+				bool lost = false;
+				ssize_t len;
+				while ((len = read(watch_fd, buffer, sizeof(buffer))) > 0)
 				{
-					return a.last_write_time() > b.last_write_time();
+					for (char* p = buffer; p < buffer + len; p += sizeof(inotify_event) + ((inotify_event*)p)->len)
+					{
+						const inotify_event* event = (const inotify_event*)p;
+						if (event->mask & (IN_Q_OVERFLOW | IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED))
+							lost = true;
+						else if (event->len > 0)
+							names.emplace(event->name);
+					}
 				}
-				return a.last_write_time() < b.last_write_time();
-			});
-		}
-
-		// Sort files
-		auto& files = dialogInfo->currentFiles;
-
-		if (fileNameSortOrder != ImGuiFileDialogSortOrder_None)
-		{
-			std::sort(files.begin(), files.end(), [](const std::filesystem::directory_entry& a, const std::filesystem::directory_entry& b)
-			{
-				if (fileNameSortOrder == ImGuiFileDialogSortOrder_Down)
+				if (lost)
 				{
-					return a.path().filename() > b.path().filename();
+					invalidate();
+					break;
 				}
 
-				return a.path().filename() < b.path().filename();
-			});
-		}
-		else if (sizeSortOrder != ImGuiFileDialogSortOrder_None)
-		{
-			std::sort(files.begin(), files.end(), [](const std::filesystem::directory_entry& a, const std::filesystem::directory_entry& b)
-			{
-				if (sizeSortOrder == ImGuiFileDialogSortOrder_Down)
+				if (!names.empty() && std::chrono::steady_clock::now() >= last_publish + PublishInterval)
 				{
-					return a.file_size() > b.file_size();
+					publish(directory, names);
+					last_publish = std::chrono::steady_clock::now();
 				}
-				return a.file_size() < b.file_size();
-			});
+			}
 		}
-		else if (typeSortOrder != ImGuiFileDialogSortOrder_None)
+		close(wake_fd);
+	}
+#endif
+
+	void watchPolling(std::stop_token const& stop, std::filesystem::path const& directory, Snapshot snapshot)
+	{
+		std::mutex wait_mutex;
+		std::condition_variable_any wait_cv;
+		std::error_code ec;
+		auto directory_time = std::filesystem::last_write_time(directory, ec);
+		for (int check = 1; !stop.stop_requested(); check++)
 		{
-			std::sort(files.begin(), files.end(), [](const std::filesystem::directory_entry& a, const std::filesystem::directory_entry& b)
 			{
-				if (typeSortOrder == ImGuiFileDialogSortOrder_Down)
-				{
-					return a.path().extension() > b.path().extension();
-				}
-
-				return a.path().extension() < b.path().extension();
-			});
+				std::unique_lock lock{ wait_mutex };
+				if (wait_cv.wait_for(lock, stop, PollInterval, [] { return false; }))
+					break;
+			}
+			if (stop.stop_requested())
+				break;
+
+			const auto time = std::filesystem::last_write_time(directory, ec);
+			if (ec)
+				return invalidate();
+			if (time == directory_time && check % PollFullEvery != 0)
+				continue;
+			directory_time = time;
+
+			// Compare a fresh listing with the previous one
+			Snapshot current;
+			current.reserve(snapshot.size());
+			std::unordered_set<std::string> names;
+			for (std::filesystem::directory_iterator it(directory, std::filesystem::directory_options::skip_permission_denied, ec), end; !ec && it != end && !stop.stop_requested(); it.increment(ec))
+			{
+				std::error_code entry_ec;
+				std::string name = it->path().filename().string();
+				const auto write_time = it->last_write_time(entry_ec);
+				const auto size = it->is_regular_file(entry_ec) ? it->file_size(entry_ec) : 0;
+				auto previous = snapshot.find(name);
+				if (previous == snapshot.end() || previous->second != std::pair{ write_time, size })
+					names.insert(name);
+				current.emplace(std::move(name), std::pair{ write_time, size });
+			}
+			if (ec)
+				return invalidate();
+			if (stop.stop_requested())
+				break;
+			for (auto& [name, info] : snapshot)
+				if (!current.contains(name))
+					names.insert(name);
+
+			snapshot = std::move(current);
+			if (!names.empty())
+				publish(directory, names);
 		}
-		else if (dateSortOrder != ImGuiFileDialogSortOrder_None)
+	}
+};
+
+// The rows shown when searching or filtering, as indices into currentDirectories/currentFiles.
+// Rebuilt when the search text, the filter or the listing changes; while only the search text is extended, the index narrows its previous matches.
+// The file index is kept across listing changes: files get a stable slot (ImFileDialogEntry::indexId) when first seen, so a listing change
+// only indexes the new files (and tests them against the search), and a new sort order only maps slots to positions again.
+// A modified file keeps its slot. Slots of removed files stay in the index until they outnumber the live ones, then the listing is indexed again.
+struct ImFileDialogFilter
+{
+	bool dirty = true;		// The listing changed
+	bool active = false;	// Otherwise every entry is shown and the vectors below are unused
+	std::string search;		// Search text and patterns the rows were built for
+	std::string patterns;
+	ig::FuzzyIndex fileIndex;
+	std::deque<std::string> fileNames;		// Names of the indexed files by slot, viewed by fileIndex
+	std::vector<uint32_t> filePositions;	// Position of each slot in currentFiles, UINT32_MAX for removed files
+	std::vector<uint32_t> directories;
+	std::vector<uint32_t> files;
+
+	void indexFiles(std::vector<ImFileDialogEntry>& entries)
+	{
+		uint32_t next_id = (uint32_t)fileNames.size();
+		const uint32_t first_new_id = next_id;
+		filePositions.assign(fileNames.size(), UINT32_MAX);
+		for (size_t i = 0; i < entries.size(); i++)
 		{
-			std::sort(files.begin(), files.end(), [](const std::filesystem::directory_entry& a, const std::filesystem::directory_entry& b)
+			ImFileDialogEntry& e = entries[i];
+			if (e.indexId == UINT32_MAX)
 			{
-				if (dateSortOrder == ImGuiFileDialogSortOrder_Down)
-				{
-					return a.last_write_time() > b.last_write_time();
-				}
-				return a.last_write_time() < b.last_write_time();
-			});
+				e.indexId = next_id++;
+				fileNames.push_back(e.name);
+				filePositions.push_back(UINT32_MAX);
+			}
+			filePositions[e.indexId] = (uint32_t)i;
 		}
-
-		size_t index = 0;
-
-		// Draw parent
-		if (dialogInfo->directoryPath.has_parent_path())
+		if (fileNames.size() - entries.size() > entries.size())
 		{
-			if (ImGui::Selectable("..", dialogInfo->currentIndex == index, ImGuiSelectableFlags_AllowDoubleClick| ImGuiSelectableFlags_SpanAllColumns|ImGuiSelectableFlags_AllowOverlap, ImVec2(ghassanpl::ig::GetWindowContentRegion().GetWidth(), 0)))
+			fileNames.clear();
+			filePositions.resize(entries.size());
+			for (size_t i = 0; i < entries.size(); i++)
 			{
-				dialogInfo->currentIndex = index;
-
-				if (ImGui::IsMouseDoubleClicked(0))
-				{
-					dialogInfo->directoryPath = dialogInfo->directoryPath.parent_path();
-					dialogInfo->refreshInfo = true;
-				}
+				entries[i].indexId = (uint32_t)i;
+				fileNames.push_back(entries[i].name);
+				filePositions[i] = (uint32_t)i;
 			}
-			ImGui::NextColumn();
-			ImGui::TextUnformatted("-");
-			ImGui::NextColumn();
-			ImGui::TextUnformatted("<parent>");
-			ImGui::NextColumn();
-			ImGui::TextUnformatted("-");
-			ImGui::NextColumn();
-			ImGui::TextUnformatted("-");
-			ImGui::NextColumn();
-
-			index++;
+			std::vector<std::string_view> names(fileNames.begin(), fileNames.end());
+			fileIndex.Build(names);
+			return;
 		}
+		if (next_id == first_new_id)
+			return;
+		std::vector<std::string_view> names(fileNames.begin() + first_new_id, fileNames.end());
+		fileIndex.Append(names);
+	}
 
-		// Draw directories
-		for (size_t i = 0; i < directories.size(); ++i)
+	void update(ImFileDialogInfo& info)
+	{
+		const std::string_view new_search = info.searchBuffer;
+		const std::string_view new_patterns = (info.filterIndex * 2 + 1 < info.filters.size()) ? std::string_view{ info.filters[info.filterIndex * 2 + 1] } : std::string_view{ "*" };
+		if (!dirty && new_search == search && new_patterns == patterns)
+			return;
+
+		if (dirty)
+			indexFiles(info.currentFiles);
+		dirty = false;
+		search = new_search;
+		patterns = new_patterns;
+		active = !search.empty() || patterns != "*";
+		directories.clear();
+		files.clear();
+		if (!active)
+			return;
+
+		// Directories are not filtered by the patterns, and are few: score them directly
+		for (size_t i = 0; i < info.currentDirectories.size(); i++)
+			if (search.empty() || ig::FuzzyIndex::FuzzyScore(search, info.currentDirectories[i].name) >= 0)
+				directories.push_back((uint32_t)i);
+
+		// Matches are slots: map them to the current positions, in display order
+		if (search.empty())
+			fileIndex.Glob(patterns, files);
+		else
 		{
-			auto const& directoryEntry = dialogInfo->currentDirectories[i];
-			auto const& directoryPath = directoryEntry.path();
-			auto directoryName = directoryPath.filename();
+			for (auto const& match : fileIndex.Search(search))
+				if (patterns == "*" || fileIndex.MatchesGlob(match.Item, patterns))
+					files.push_back(match.Item);
+		}
+		size_t count = 0;
+		for (const uint32_t id : files)
+			if (filePositions[id] != UINT32_MAX)
+				files[count++] = filePositions[id];
+		files.resize(count);
+		std::sort(files.begin(), files.end());
+	}
+};
 
-			if (ImGui::Selectable(directoryName.string().c_str(), dialogInfo->currentIndex == index, ImGuiSelectableFlags_AllowDoubleClick | ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowOverlap, ImVec2(ghassanpl::ig::GetWindowContentRegion().GetWidth(), 0)))
-			{
-				dialogInfo->currentIndex = index;
+void ImFileDialogInfo::refreshPaths()
+{
+	clearEntries();
+	refreshInfo = false;
+	scanned = true;
 
-				if (ImGui::IsMouseDoubleClicked(0))
-				{
-					dialogInfo->directoryPath = directoryPath;
-					dialogInfo->refreshInfo = true;
-				}
-			}
+	std::error_code ec;
+	if (!std::filesystem::exists(directoryPath, ec))
+		directoryPath = std::filesystem::current_path();
+
+	scan = std::make_shared<ImFileDialogScan>();
+	scan->thread = std::jthread{ [s = scan.get(), directory = directoryPath, watch = watchDirectory](std::stop_token stop) { s->run(stop, directory, watch); } };
+}
+
+// Removes the entries named in 'names', keeping the order of the rest, and records their index slots in 'names';
+// returns how many of the first 'sorted_count' entries remain
+static size_t ImFileDialogEraseEntries(std::vector<ImFileDialogEntry>& entries, size_t sorted_count, std::unordered_map<std::string, uint32_t>& names)
+{
+	size_t sorted_removed = 0;
+	const ImFileDialogEntry* first = entries.data();
+	auto new_end = std::remove_if(entries.begin(), entries.end(), [&](ImFileDialogEntry const& e) {
+		auto it = names.find(e.name);
+		if (it == names.end())
+			return false;
+		it->second = e.indexId;
+		if ((size_t)(&e - first) < sorted_count)
+			sorted_removed++;
+		return true;
+	});
+	entries.erase(new_end, entries.end());
+	return sorted_count - sorted_removed;
+}
+
+void ImFileDialogInfo::pollScan()
+{
+	if (!scan)
+		return;
+
+	std::vector<ImFileDialogEntry> found, changed;
+	std::vector<std::string> removed;
+	bool done, invalidated;
+	{
+		std::lock_guard lock{ scan->mutex };
+		found.swap(scan->pending);
+		changed.swap(scan->changed);
+		removed.swap(scan->removed);
+		done = scan->done;
+		invalidated = scan->invalidated;
+	}
 
-			ImGui::NextColumn();
-			ImGui::TextUnformatted("-");
-			ImGui::NextColumn();
-			ImGui::TextUnformatted("<directory>");
-			ImGui::NextColumn();
-
-			auto lastWriteTime = directoryEntry.last_write_time();
-			auto st = std::chrono::time_point_cast<std::chrono::system_clock::duration>(lastWriteTime - decltype(lastWriteTime)::clock::now() + std::chrono::system_clock::now());
-			
-			ig::Text("{0:%F} {0:%R}", st);
-			ImGui::NextColumn();
-			ImGui::TextUnformatted("-");
-			ImGui::NextColumn();
-
-			index++;
+	// New entries are appended; FileDialog() merges them into the sort order
+	const auto append_entries = [this](std::vector<ImFileDialogEntry>& entries) {
+		for (ImFileDialogEntry& e : entries)
+		{
+			if (e.isDirectory)
+				currentDirectories.push_back(std::move(e));
+			else if (fileFilterFunc == nullptr || fileFilterFunc(e.entry)) // User filter runs on this thread
+				currentFiles.push_back(std::move(e));
 		}
+	};
+
+	// Entries found by the enumeration go in first, so that a change reported in the same poll replaces them instead of adding a duplicate
+	append_entries(found);
+
+	// Changes while watching: drop the previous version of every entry named, in a single pass.
+	// A file replacing its previous version takes over its index slot, as the name is the same.
+	if (!changed.empty() || !removed.empty())
+	{
+		std::unordered_map<std::string, uint32_t> names;
+		for (std::string& name : removed)
+			names.emplace(std::move(name), UINT32_MAX);
+		for (ImFileDialogEntry const& e : changed)
+			names.emplace(e.name, UINT32_MAX);
+		sortedDirectories = ImFileDialogEraseEntries(currentDirectories, sortedDirectories, names);
+		sortedFiles = ImFileDialogEraseEntries(currentFiles, sortedFiles, names);
+		for (ImFileDialogEntry& e : changed)
+			if (!e.isDirectory)
+				e.indexId = names[e.name];
+		append_entries(changed);
+	}
+
+	if (!found.empty() || !changed.empty() || !removed.empty())
+		invalidateFilter();
+
+	if (invalidated)
+		refreshInfo = true;
+	else if (done && !watchDirectory)
+		scan.reset();
+	else if (done)
+		watching = true;
+}
 
-		// Draw files
-		for (size_t i = 0; i < files.size(); ++i)
+void ImFileDialogInfo::cancelScan()
+{
+	scan.reset();
+	watching = false;
+}
+
+void ImFileDialogInfo::invalidateSort()
+{
+	sortedDirectories = sortedFiles = 0;
+}
+
+void ImFileDialogInfo::invalidateFilter()
+{
+	if (filtered)
+		filtered->dirty = true;
+}
+
+void ImFileDialogInfo::clearEntries()
+{
+	cancelScan();
+	scanned = false;
+	currentIndex = 0;
+	currentFiles.clear();
+	currentDirectories.clear();
+	invalidateSort();
+	filtered.reset(); // Drops the search index
+}
+
+bool ImFileDialogInfo::isScanning() const
+{
+	return scan != nullptr && !watching;
+}
+
+bool ImGui::FileDialog(bool* open, ImFileDialogInfo* dialogInfo)
+{
+	if (!*open) return false;
+
+	assert(dialogInfo != nullptr);
+
+	bool complete = false;
+
+	ImGui::PushID(dialogInfo);
+	ImGui::SetNextWindowSize(ImVec2(740.0f, 410.0f), ImGuiCond_FirstUseEver);
+
+	if (ImGui::Begin(dialogInfo->title.c_str(), open))
+	{
+		if (!dialogInfo->scanned || dialogInfo->refreshInfo)
+			dialogInfo->refreshPaths();
+		dialogInfo->pollScan();
+
+		// Draw path
+		ImGui::Text("Path: %s", dialogInfo->directoryPath.string().c_str());
+		if (dialogInfo->isScanning())
 		{
-			auto const& fileEntry = dialogInfo->currentFiles[i];
-			auto const& filePath = fileEntry.path();
-			auto fileName = filePath.filename();
+			ImGui::SameLine();
+			ImGui::TextDisabled("(scanning... %d entries)", (int)(dialogInfo->currentDirectories.size() + dialogInfo->currentFiles.size()));
+		}
 
-			if (ImGui::Selectable(fileName.string().c_str(), dialogInfo->currentIndex == index, ImGuiSelectableFlags_AllowDoubleClick| ImGuiSelectableFlags_SpanAllColumns|ImGuiSelectableFlags_AllowOverlap, ImVec2(ghassanpl::ig::GetWindowContentRegion().GetWidth(), 0)))
-			{
-				dialogInfo->currentIndex = index;
-				dialogInfo->fileName = fileName;
-			}
+		// Draw search
+		const float searchWidth = 200.0f;
+		ImGui::SameLine();
+		ImGui::SetCursorPosX(ImMax(ImGui::GetCursorPosX(), ImGui::GetCursorPosX() + ImGui::GetContentRegionAvail().x - searchWidth));
+		ImGui::SetNextItemWidth(searchWidth);
+		if (ImGui::InputTextWithHint("##search", "Search", dialogInfo->searchBuffer, sizeof(dialogInfo->searchBuffer)))
+			dialogInfo->currentIndex = 0;
 
-			ImGui::NextColumn();
-			ImGui::TextUnformatted(std::to_string(fileEntry.file_size()).c_str());
-			ImGui::NextColumn();
-			ImGui::TextUnformatted(filePath.extension().string().c_str());
-			ImGui::NextColumn();
+		auto content_region = ig::GetWindowContentRegion();
+		auto bottom_h = GetFrameHeightWithSpacing() * 3;
 
-			auto lastWriteTime = fileEntry.last_write_time();
-			auto st = std::chrono::time_point_cast<std::chrono::system_clock::duration>(lastWriteTime - decltype(lastWriteTime)::clock::now() + std::chrono::system_clock::now());
+		const ImGuiTableFlags table_flags = ImGuiTableFlags_Resizable | ImGuiTableFlags_Sortable | ImGuiTableFlags_SortTristate | ImGuiTableFlags_ScrollX | ImGuiTableFlags_ScrollY | ImGuiTableFlags_BordersOuter | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingFixedFit;
+		if (ImGui::BeginTable("##browser", 5, table_flags, ImVec2(content_region.GetWidth(), content_region.GetHeight() - bottom_h)))
+		{
+			// The sort order set on dialogInfo becomes the table's initial sort
+			auto sort_flags = [](ImGuiFileDialogSortOrder order) -> ImGuiTableColumnFlags {
+				if (order == ImGuiFileDialogSortOrder_None)
+					return ImGuiTableColumnFlags_None;
+				return ImGuiTableColumnFlags_DefaultSort | (order == ImGuiFileDialogSortOrder_Down ? ImGuiTableColumnFlags_PreferSortDescending : ImGuiTableColumnFlags_PreferSortAscending);
+			};
+			ImGui::TableSetupColumn("Name", sort_flags(dialogInfo->fileNameSortOrder), 230.0f);
+			ImGui::TableSetupColumn("Size", sort_flags(dialogInfo->sizeSortOrder), 80.0f);
+			ImGui::TableSetupColumn("Type", sort_flags(dialogInfo->typeSortOrder), 90.0f);
+			ImGui::TableSetupColumn("Date", sort_flags(dialogInfo->dateSortOrder), 150.0f);
+			ImGui::TableSetupColumn("Actions", ImGuiTableColumnFlags_NoSort | ImGuiTableColumnFlags_WidthStretch);
+			ImGui::TableSetupScrollFreeze(0, 1);
+			ImGui::TableHeadersRow();
+
+			// Sort order from table headers
+			if (ImGuiTableSortSpecs* sort_specs = ImGui::TableGetSortSpecs(); sort_specs && sort_specs->SpecsDirty)
+			{
+				ImGuiFileDialogSortOrder* orders[] = { &dialogInfo->fileNameSortOrder, &dialogInfo->sizeSortOrder, &dialogInfo->typeSortOrder, &dialogInfo->dateSortOrder };
+				for (ImGuiFileDialogSortOrder* order : orders)
+					*order = ImGuiFileDialogSortOrder_None;
+				if (sort_specs->SpecsCount > 0 && sort_specs->Specs[0].ColumnIndex < IM_ARRAYSIZE(orders))
+					*orders[sort_specs->Specs[0].ColumnIndex] = (sort_specs->Specs[0].SortDirection == ImGuiSortDirection_Descending) ? ImGuiFileDialogSortOrder_Down : ImGuiFileDialogSortOrder_Up;
+				dialogInfo->invalidateSort();
+				sort_specs->SpecsDirty = false;
+			}
 
-			ig::Text("{0:%F} {0:%R}", st);
-			ImGui::NextColumn();
-			if (dialogInfo->fileActionCallback)
-				dialogInfo->fileActionCallback(fileEntry);
-			ImGui::NextColumn();
+			// Sort, using the keys gathered by the scan. Entries appended since the last frame are sorted and merged into the sorted prefix,
+			// the whole list is only sorted again when the order changes.
+			auto& directories = dialogInfo->currentDirectories;
+			auto& files = dialogInfo->currentFiles;
+			if (dialogInfo->sortedDirectories != directories.size() || dialogInfo->sortedFiles != files.size())
+			{
+				auto sort_by = [](std::vector<ImFileDialogEntry>& entries, size_t sorted_count, ImGuiFileDialogSortOrder order, auto key) {
+					auto sort_range = [&](auto less) {
+						const auto middle = entries.begin() + sorted_count;
+						std::stable_sort(middle, entries.end(), less);
+						std::inplace_merge(entries.begin(), middle, entries.end(), less);
+					};
+					if (order == ImGuiFileDialogSortOrder_Down)
+						sort_range([&](const ImFileDialogEntry& a, const ImFileDialogEntry& b) { return key(a) > key(b); });
+					else
+						sort_range([&](const ImFileDialogEntry& a, const ImFileDialogEntry& b) { return key(a) < key(b); });
+				};
+				auto by_name = [](const ImFileDialogEntry& e) -> const std::string& { return e.name; };
+				auto by_size = [](const ImFileDialogEntry& e) { return e.size; };
+				auto by_type = [](const ImFileDialogEntry& e) -> const std::string& { return e.extension; };
+				auto by_date = [](const ImFileDialogEntry& e) { return e.lastWriteTime; };
+
+				const size_t sorted_directories = dialogInfo->sortedDirectories;
+				const size_t sorted_files = dialogInfo->sortedFiles;
+				if (dialogInfo->fileNameSortOrder != ImGuiFileDialogSortOrder_None || dialogInfo->sizeSortOrder != ImGuiFileDialogSortOrder_None || dialogInfo->typeSortOrder != ImGuiFileDialogSortOrder_None)
+					sort_by(directories, sorted_directories, dialogInfo->fileNameSortOrder, by_name);
+				else if (dialogInfo->dateSortOrder != ImGuiFileDialogSortOrder_None)
+					sort_by(directories, sorted_directories, dialogInfo->dateSortOrder, by_date);
+
+				if (dialogInfo->fileNameSortOrder != ImGuiFileDialogSortOrder_None)
+					sort_by(files, sorted_files, dialogInfo->fileNameSortOrder, by_name);
+				else if (dialogInfo->sizeSortOrder != ImGuiFileDialogSortOrder_None)
+					sort_by(files, sorted_files, dialogInfo->sizeSortOrder, by_size);
+				else if (dialogInfo->typeSortOrder != ImGuiFileDialogSortOrder_None)
+					sort_by(files, sorted_files, dialogInfo->typeSortOrder, by_type);
+				else if (dialogInfo->dateSortOrder != ImGuiFileDialogSortOrder_None)
+					sort_by(files, sorted_files, dialogInfo->dateSortOrder, by_date);
+
+				dialogInfo->sortedDirectories = directories.size();
+				dialogInfo->sortedFiles = files.size();
+				dialogInfo->invalidateFilter();
+			}
 
-			index++;
+			if (!dialogInfo->filtered)
+				dialogInfo->filtered = std::make_shared<ImFileDialogFilter>();
+			ImFileDialogFilter& filtered = *dialogInfo->filtered;
+			filtered.update(*dialogInfo);
+			auto directory_at = [&](size_t i) -> ImFileDialogEntry const& { return directories[filtered.active ? filtered.directories[i] : i]; };
+			auto file_at = [&](size_t i) -> ImFileDialogEntry const& { return files[filtered.active ? filtered.files[i] : i]; };
+			const size_t directory_count = filtered.active ? filtered.directories.size() : directories.size();
+			const size_t file_count = filtered.active ? filtered.files.size() : files.size();
+
+			// Rows: [parent], directories, files. Only visible rows are submitted, with the text preformatted by the scan.
+			const ImGuiSelectableFlags selectable_flags = ImGuiSelectableFlags_AllowDoubleClick | ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowOverlap;
+			const size_t parent_count = dialogInfo->directoryPath.has_parent_path() ? 1 : 0;
+			const size_t row_count = parent_count + directory_count + file_count;
+
+			ImGuiListClipper clipper;
+			clipper.Begin((int)row_count);
+			while (clipper.Step())
+			{
+				for (size_t index = (size_t)clipper.DisplayStart; index < (size_t)clipper.DisplayEnd; index++)
+				{
+					ImGui::TableNextRow();
+					ImGui::TableNextColumn();
+					ImGui::PushID((int)index);
+
+					if (index < parent_count)
+					{
+						// Draw parent
+						if (ImGui::Selectable("..", dialogInfo->currentIndex == index, selectable_flags))
+						{
+							dialogInfo->currentIndex = index;
+
+							if (ImGui::IsMouseDoubleClicked(0))
+							{
+								dialogInfo->directoryPath = dialogInfo->directoryPath.parent_path();
+								dialogInfo->refreshInfo = true;
+							}
+						}
+						ImGui::TableNextColumn();
+						ImGui::TextUnformatted("-");
+						ImGui::TableNextColumn();
+						ImGui::TextUnformatted("<parent>");
+						ImGui::TableNextColumn();
+						ImGui::TextUnformatted("-");
+						ImGui::TableNextColumn();
+						ImGui::TextUnformatted("-");
+					}
+					else if (index < parent_count + directory_count)
+					{
+						// Draw directory
+						auto const& directoryEntry = directory_at(index - parent_count);
+
+						if (ImGui::Selectable(directoryEntry.name.c_str(), dialogInfo->currentIndex == index, selectable_flags))
+						{
+							dialogInfo->currentIndex = index;
+
+							if (ImGui::IsMouseDoubleClicked(0))
+							{
+								dialogInfo->directoryPath = directoryEntry.entry.path();
+								dialogInfo->refreshInfo = true;
+							}
+						}
+						ImGui::TableNextColumn();
+						ImGui::TextUnformatted("-");
+						ImGui::TableNextColumn();
+						ImGui::TextUnformatted("<directory>");
+						ImGui::TableNextColumn();
+						ImGui::TextUnformatted(directoryEntry.dateText.c_str());
+						ImGui::TableNextColumn();
+						ImGui::TextUnformatted("-");
+					}
+					else
+					{
+						// Draw file
+						auto const& fileEntry = file_at(index - parent_count - directory_count);
+
+						if (ImGui::Selectable(fileEntry.name.c_str(), dialogInfo->currentIndex == index, selectable_flags))
+						{
+							dialogInfo->currentIndex = index;
+							dialogInfo->fileName = fileEntry.entry.path().filename();
+						}
+						ImGui::TableNextColumn();
+						ImGui::TextUnformatted(fileEntry.sizeText.c_str());
+						ImGui::TableNextColumn();
+						ImGui::TextUnformatted(fileEntry.extension.c_str());
+						ImGui::TableNextColumn();
+						ImGui::TextUnformatted(fileEntry.dateText.c_str());
+						ImGui::TableNextColumn();
+						if (dialogInfo->fileActionCallback)
+							dialogInfo->fileActionCallback(fileEntry.entry);
+					}
+
+					ImGui::PopID();
+				}
+			}
+			ImGui::EndTable();
 		}
-		ImGui::EndChild();
 
 		// Draw filename
-		static const size_t fileNameBufferSize = 200;
-		static char fileNameBuffer[fileNameBufferSize];
+		char* fileNameBuffer = dialogInfo->fileNameBuffer;
+		const size_t fileNameBufferSize = sizeof(dialogInfo->fileNameBuffer);
 
 		std::string fileNameStr = dialogInfo->fileName.string();
 		size_t fileNameSize = fileNameStr.size();
@@ -333,12 +723,38 @@ bool ImGui::FileDialog(bool* open, ImFileDialogInfo* dialogInfo)
 		std::memcpy(fileNameBuffer, fileNameStr.c_str(), fileNameSize);
 		fileNameBuffer[fileNameSize] = 0;
 
-		ImGui::PushItemWidth(ghassanpl::ig::GetWindowContentRegion().GetWidth());
+		// Draw filter (next to the filename) when there is a choice
+		const float filterWidth = dialogInfo->filters.size() >= 4 ? 200.0f : 0.0f;
+		ImGui::PushItemWidth(ghassanpl::ig::GetWindowContentRegion().GetWidth() - (filterWidth > 0.0f ? filterWidth + ImGui::GetStyle().ItemSpacing.x : 0.0f));
 		if (ImGui::InputText("File Name", fileNameBuffer, fileNameBufferSize))
 		{
 			dialogInfo->fileName = std::string(fileNameBuffer);
 			dialogInfo->currentIndex = 0;
 		}
+		ImGui::PopItemWidth();
+
+		if (filterWidth > 0.0f)
+		{
+			const size_t filterCount = dialogInfo->filters.size() / 2;
+			if (dialogInfo->filterIndex >= filterCount)
+				dialogInfo->filterIndex = 0;
+			ImGui::SameLine();
+			ImGui::SetNextItemWidth(filterWidth);
+			if (ImGui::BeginCombo("##filter", dialogInfo->filters[dialogInfo->filterIndex * 2].c_str()))
+			{
+				for (size_t i = 0; i < filterCount; i++)
+				{
+					ImGui::PushID((int)i);
+					if (ImGui::Selectable(dialogInfo->filters[i * 2].c_str(), i == dialogInfo->filterIndex))
+					{
+						dialogInfo->filterIndex = i;
+						dialogInfo->currentIndex = 0;
+					}
+					ImGui::PopID();
+				}
+				ImGui::EndCombo();
+			}
+		}
 
 		if (dialogInfo->type == ImGuiFileDialogType_OpenFile)
 		{
@@ -348,15 +764,13 @@ bool ImGui::FileDialog(bool* open, ImFileDialogInfo* dialogInfo)
 
 				if (std::filesystem::exists(dialogInfo->resultPath))
 				{
-					fileNameSortOrder = ImGuiFileDialogSortOrder_None;
-					sizeSortOrder = ImGuiFileDialogSortOrder_None;
-					typeSortOrder = ImGuiFileDialogSortOrder_None;
-					dateSortOrder = ImGuiFileDialogSortOrder_None;
+					dialogInfo->fileNameSortOrder = ImGuiFileDialogSortOrder_None;
+					dialogInfo->sizeSortOrder = ImGuiFileDialogSortOrder_None;
+					dialogInfo->typeSortOrder = ImGuiFileDialogSortOrder_None;
+					dialogInfo->dateSortOrder = ImGuiFileDialogSortOrder_None;
 
 					dialogInfo->refreshInfo = false;
-					dialogInfo->currentIndex = 0;
-					dialogInfo->currentFiles.clear();
-					dialogInfo->currentDirectories.clear();
+					dialogInfo->clearEntries();
 
 					complete = true;
 					*open = false;
@@ -371,15 +785,13 @@ bool ImGui::FileDialog(bool* open, ImFileDialogInfo* dialogInfo)
 
 				if (!std::filesystem::exists(dialogInfo->resultPath))
 				{
-					fileNameSortOrder = ImGuiFileDialogSortOrder_None;
-					sizeSortOrder = ImGuiFileDialogSortOrder_None;
-					typeSortOrder = ImGuiFileDialogSortOrder_None;
-					dateSortOrder = ImGuiFileDialogSortOrder_None;
+					dialogInfo->fileNameSortOrder = ImGuiFileDialogSortOrder_None;
+					dialogInfo->sizeSortOrder = ImGuiFileDialogSortOrder_None;
+					dialogInfo->typeSortOrder = ImGuiFileDialogSortOrder_None;
+					dialogInfo->dateSortOrder = ImGuiFileDialogSortOrder_None;
 
 					dialogInfo->refreshInfo = false;
-					dialogInfo->currentIndex = 0;
-					dialogInfo->currentFiles.clear();
-					dialogInfo->currentDirectories.clear();
+					dialogInfo->clearEntries();
 
 					complete = true;
 					*open = false;
@@ -391,15 +803,13 @@ bool ImGui::FileDialog(bool* open, ImFileDialogInfo* dialogInfo)
 
 		if (ImGui::Button("Cancel"))
 		{
-			fileNameSortOrder = ImGuiFileDialogSortOrder_None;
-			sizeSortOrder = ImGuiFileDialogSortOrder_None;
-			typeSortOrder = ImGuiFileDialogSortOrder_None;
-			dateSortOrder = ImGuiFileDialogSortOrder_None;
+			dialogInfo->fileNameSortOrder = ImGuiFileDialogSortOrder_None;
+			dialogInfo->sizeSortOrder = ImGuiFileDialogSortOrder_None;
+			dialogInfo->typeSortOrder = ImGuiFileDialogSortOrder_None;
+			dialogInfo->dateSortOrder = ImGuiFileDialogSortOrder_None;
 
 			dialogInfo->refreshInfo = false;
-			dialogInfo->currentIndex = 0;
-			dialogInfo->currentFiles.clear();
-			dialogInfo->currentDirectories.clear();
+			dialogInfo->clearEntries();
 
 			*open = false;
 		}
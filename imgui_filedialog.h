@@ -12,6 +12,7 @@
 #include <string>
 #include <vector>
 #include <functional>
+#include <memory>
 
 typedef int ImGuiFileDialogType;	// -> enum ImGuiFileDialogType_        // Enum: A file dialog type
 
@@ -22,6 +23,32 @@ enum ImGuiFileDialogType_
 	ImGuiFileDialogType_COUNT
 };
 
+typedef int ImGuiFileDialogSortOrder;	// -> enum ImGuiFileDialogSortOrder_   // Enum: A file dialog column sort order
+
+enum ImGuiFileDialogSortOrder_
+{
+	ImGuiFileDialogSortOrder_Up,
+	ImGuiFileDialogSortOrder_Down,
+	ImGuiFileDialogSortOrder_None
+};
+
+// A directory entry with the information displayed/sorted by the dialog, gathered once when the directory is scanned
+struct ImFileDialogEntry
+{
+	std::filesystem::directory_entry entry;
+	std::string name;						// filename, UTF-8
+	std::string extension;
+	std::uintmax_t size = 0;
+	std::filesystem::file_time_type lastWriteTime = {};
+	bool isDirectory = false;
+	std::string sizeText;					// size and lastWriteTime as displayed
+	std::string dateText;
+	uint32_t indexId = UINT32_MAX;			// Slot of a file in the dialog's search index, assigned by the dialog. Reset it if you change 'name' in place.
+};
+
+struct ImFileDialogScan;	// Background directory enumeration, see ImFileDialogInfo::refreshPaths()
+struct ImFileDialogFilter;	// Rows left by the search and filter, see ImFileDialogInfo::invalidateFilter()
+
 struct ImFileDialogInfo
 {
 	std::string title = "Open File";
@@ -33,16 +60,41 @@ struct ImFileDialogInfo
 
 	bool refreshInfo;
 	size_t currentIndex;
-	std::vector<std::filesystem::directory_entry> currentFiles;
-	std::vector<std::filesystem::directory_entry> currentDirectories;
+	std::vector<ImFileDialogEntry> currentFiles;
+	std::vector<ImFileDialogEntry> currentDirectories;
 	std::function<bool(std::filesystem::directory_entry const&)> fileFilterFunc = {};
 
-    /// TODO: This
-    std::vector<std::string> filters = { "All Files", "*" };
+	// Pairs of a description and ';' separated glob patterns ('*' and '?' wildcards), e.g. { "All Files", "*", "Images", "*.png;*.jpg" }
+	std::vector<std::string> filters = { "All Files", "*" };
+	size_t filterIndex = 0;		// Pair of `filters` applied to the files listed
+	char searchBuffer[200] = {};	// Fuzzy search over the names listed
 
     std::function<void(std::filesystem::directory_entry const&)> fileActionCallback = {};
 
-	void refreshPaths();
+	// UI state, kept per dialog so that dialogs in different contexts/threads don't share it
+	ImGuiFileDialogSortOrder fileNameSortOrder = ImGuiFileDialogSortOrder_None;
+	ImGuiFileDialogSortOrder sizeSortOrder = ImGuiFileDialogSortOrder_None;
+	ImGuiFileDialogSortOrder dateSortOrder = ImGuiFileDialogSortOrder_None;
+	ImGuiFileDialogSortOrder typeSortOrder = ImGuiFileDialogSortOrder_None;
+	char fileNameBuffer[200] = {};
+	size_t sortedDirectories = 0;	// Number of leading entries of currentDirectories/currentFiles already in sort order
+	size_t sortedFiles = 0;
+
+	// Directory scanning runs on a background thread; entries are appended to currentFiles/currentDirectories by pollScan() as they arrive.
+	// Once scanned, the directory is watched (inotify on Linux, polling elsewhere) and changes on disk are applied to the lists as they happen.
+	bool watchDirectory = true;	// Must be set before the directory is scanned
+	bool scanned = false;		// Set when a scan of directoryPath was started; clear to scan again
+	bool watching = false;		// Scan complete, watching for changes
+	std::shared_ptr<ImFileDialogScan> scan;
+	std::shared_ptr<ImFileDialogFilter> filtered;
+
+	void refreshPaths();	// Start (re)scanning directoryPath
+	void pollScan();		// Collect entries found so far, and changes since. Called by FileDialog() every frame
+	void cancelScan();
+	bool isScanning() const;
+	void invalidateSort();
+	void invalidateFilter();	// Call after changing currentFiles/currentDirectories; changes to filters/filterIndex/searchBuffer are detected
+	void clearEntries();	// Also cancels scanning; the directory is scanned again the next time the dialog is shown
 };
 
 namespace ImGui
@@ -126,6 +126,7 @@ struct ImDrawDataBuilder;           // Helper to build a ImDrawData instance
 struct ImDrawListSharedData;        // Data shared between all ImDrawList instances
 struct ImGuiBoxSelectState;         // Box-selection state (currently used by multi-selection, could potentially be used by others)
 struct ImGuiColorMod;               // Stacked color modifier, backup of modified data so we can restore it
+struct ImGuiColorPickerWheelCache;  // Cached geometry of the ColorPicker4() hue wheel
 struct ImGuiContext;                // Main Dear ImGui context
 struct ImGuiContextHook;            // Hook for extensions like ImGuiTestEngine
 struct ImGuiDataVarInfo;            // Variable information (e.g. to access style variables from an enum)
@@ -145,6 +146,8 @@ struct ImGuiNextItemData;           // Storage for SetNextItem** functions
 struct ImGuiOldColumnData;          // Storage data for a single column for legacy Columns() api
 struct ImGuiOldColumns;             // Storage data for a columns set for legacy Columns() api
 struct ImGuiPopupData;              // Storage for current popup stack
+struct ImGuiSettingsAsyncWriter;    // Background .ini file writer (IMGUI_ENABLE_ASYNC_INI_SAVING)
+struct ImGuiSettingsBinaryReader;   // Helper to read a binary settings block
 struct ImGuiSettingsHandler;        // Storage for one type registered in the .ini file
 struct ImGuiStackSizes;             // Storage of stack sizes for debugging/asserting
 struct ImGuiStyleMod;               // Stacked style modifier, backup of modified data so we can restore it
@@ -194,8 +197,12 @@ typedef void (*ImGuiErrorLogCallback)(void* user_data, const char* fmt, ...);
 //-----------------------------------------------------------------------------
 
 #ifndef GImGui
+#ifdef IMGUI_THREAD_LOCAL_CONTEXT
+extern thread_local ImGuiContext* GImGui;   // Current implicit context pointer, one per thread
+#else
 extern IMGUI_API ImGuiContext* GImGui;  // Current implicit context pointer
 #endif
+#endif
 
 //-------------------------------------------------------------------------
 // [SECTION] STB libraries includes
@@ -679,6 +686,52 @@ struct ImSpanAllocator
     inline void  GetSpan(int n, ImSpan<T>* span)    { span->set((T*)GetSpanPtrBegin(n), (T*)GetSpanPtrEnd(n)); }
 };
 
+// Helper: ImFrameArena
+// Bump allocator for data which doesn't outlive the frame. Allocations are never moved nor individually freed.
+// - When the current block is full a larger one is chained. On Reset() chained blocks are replaced by a single block large enough
+//   for the whole frame, so steady-state frames don't call MemAlloc() at all.
+struct ImFrameArenaBlock
+{
+    char*       Data;
+    size_t      Size;
+};
+
+struct IMGUI_API ImFrameArena
+{
+    ImVector<ImFrameArenaBlock> Blocks;     // Blocks.back() is the current block
+    size_t      BlockOffset;                // Bytes used in the current block
+    size_t      FrameBytes;                 // Bytes allocated since last Reset()
+    int         FrameAllocCount;            // Number of allocations since last Reset()
+    size_t      LastFrameBytes;
+    int         LastFrameAllocCount;
+    size_t      HighWaterMark;              // Largest FrameBytes
+    int         BlocksAllocCount;           // Number of blocks allocated with MemAlloc()
+    int         TrimFrames;                 // Frames between checks for shrinking the block, when the largest of them used less than half of it
+    int         RecentFrames;               // Frames since the last trim check
+    size_t      RecentPeakBytes;            // Largest FrameBytes since the last trim check
+
+    ImFrameArena()                          { BlockOffset = FrameBytes = LastFrameBytes = HighWaterMark = RecentPeakBytes = 0; FrameAllocCount = LastFrameAllocCount = BlocksAllocCount = RecentFrames = 0; TrimFrames = 120; }
+    ~ImFrameArena()                         { Clear(); }
+    void*       Alloc(size_t size, size_t align = 16);
+    size_t      GetCapacity() const         { size_t capacity = 0; for (const ImFrameArenaBlock& block : Blocks) capacity += block.Size; return capacity; }
+    void        Reset();                    // Invalidate all allocations
+    void        Clear();                    // Invalidate all allocations and free all blocks
+};
+
+// Helper: ImGuiAllocatorScope
+// Route MemAlloc()/MemFree() calls made on the current thread to the given allocator for the lifetime of the scope, whatever the current context.
+// Used by ImFontAtlas functions when the atlas has its own allocator. Does nothing when alloc_func is NULL.
+struct IMGUI_API ImGuiAllocatorScope
+{
+    ImGuiMemAllocFunc       AllocFunc;
+    ImGuiMemFreeFunc        FreeFunc;
+    void*                   UserData;
+    ImGuiAllocatorScope*    Previous;
+
+    ImGuiAllocatorScope(ImGuiMemAllocFunc alloc_func, ImGuiMemFreeFunc free_func, void* user_data);
+    ~ImGuiAllocatorScope();
+};
+
 // Helper: ImPool<>
 // Basic keyed storage for contiguous instances, slow/amortized insertion, O(1) indexable, O(Log N) queries by ID over a dense/hot buffer,
 // Honor constructor/destructor. Add/remove invalidate all pointers. Indexes have the same lifetime as the associated object.
@@ -1073,6 +1126,25 @@ struct IMGUI_API ImGuiComboPreviewData
     ImGuiComboPreviewData() { memset(this, 0, sizeof(*this)); }
 };
 
+// Cached geometry of the ColorPicker4() hue wheel, relative to its center.
+// Stroking and shading the wheel is most of the cost of a picker, and only depends on its size and on the style, not on the color.
+#define IMGUI_COLOR_PICKER_WHEEL_CACHE_MAX  8   // Number of different sizes/styles kept
+struct IMGUI_API ImGuiColorPickerWheelCache
+{
+    float           RadiusInner;
+    float           RadiusOuter;
+    ImU32           ColAlpha;                   // Style alpha, in IM_COL32_A_MASK
+    ImDrawListFlags DrawListFlags;
+    float           FringeScale;
+    ImVec2          TexUvWhitePixel;
+    const ImVec4*   TexUvLines;
+    int             LastFrameUsed;
+    ImVector<ImDrawVert> VtxBuffer;
+    ImVector<ImDrawIdx>  IdxBuffer;             // Relative to the first vertex
+
+    ImGuiColorPickerWheelCache() { RadiusInner = RadiusOuter = FringeScale = 0.0f; ColAlpha = 0; DrawListFlags = 0; TexUvWhitePixel = ImVec2(); TexUvLines = NULL; LastFrameUsed = -1; }
+};
+
 // Stacked storage data for BeginGroup()/EndGroup()
 struct IMGUI_API ImGuiGroupData
 {
@@ -1865,11 +1937,34 @@ struct ImGuiSettingsHandler
     void        (*ReadLineFn)(ImGuiContext* ctx, ImGuiSettingsHandler* handler, void* entry, const char* line); // Read: Called for every line of text within an ini entry
     void        (*ApplyAllFn)(ImGuiContext* ctx, ImGuiSettingsHandler* handler);                                // Read: Called after reading (in registration order)
     void        (*WriteAllFn)(ImGuiContext* ctx, ImGuiSettingsHandler* handler, ImGuiTextBuffer* out_buf);      // Write: Output every entries into 'out_buf'
+    void        (*ReadBinaryFn)(ImGuiContext* ctx, ImGuiSettingsHandler* handler, int version, ImGuiSettingsBinaryReader* reader); // Read (binary, optional): Called with the data block written by WriteBinaryFn, between ReadInitFn and ApplyAllFn
+    void        (*WriteBinaryFn)(ImGuiContext* ctx, ImGuiSettingsHandler* handler, ImGuiTextBuffer* out_buf);   // Write (binary, optional): Output every entries into 'out_buf'. Handlers without it are stored as text in binary files.
+    int         BinaryVersion;  // Version of the data written by WriteBinaryFn, passed back to ReadBinaryFn. Must be >= 1.
     void*       UserData;
 
+    // [Internal]
+    bool        WantSave;           // Set by MarkIniSettingsDirty(). When saving in binary format, the previous block of a handler is reused as long as this is not set.
+    int         BinaryCacheOffset;  // Location of the block last written in binary format, in g.SettingsIniData
+    int         BinaryCacheSize;    // (0 when not available)
+
     ImGuiSettingsHandler() { memset(this, 0, sizeof(*this)); }
 };
 
+// Helper to read ImGuiSettingsHandler binary blocks (values are stored unaligned and in native endianness, see ImGuiSettingsBinaryWrite())
+// Reading past the end of the block returns zeroes and sets Overflow, so handlers can decode everything and check once.
+struct ImGuiSettingsBinaryReader
+{
+    const char* Data;
+    const char* DataEnd;
+    bool        Overflow;
+
+    ImGuiSettingsBinaryReader(const char* data, const char* data_end) { Data = data; DataEnd = data_end; Overflow = false; }
+    bool        IsEnd() const           { return Data >= DataEnd; }
+    const char* ReadBytes(int size)     { if (size < 0 || DataEnd - Data < size) { Data = DataEnd; Overflow = true; return NULL; } const char* p = Data; Data += size; return p; }
+    template<typename T> T Read()       { T v; if (const char* p = ReadBytes((int)sizeof(T))) memcpy(&v, p, sizeof(T)); else memset(&v, 0, sizeof(T)); return v; }
+};
+template<typename T> static inline void ImGuiSettingsBinaryWrite(ImGuiTextBuffer* buf, const T& v) { buf->append((const char*)&v, (const char*)&v + sizeof(T)); }
+
 //-----------------------------------------------------------------------------
 // [SECTION] Localization support
 //-----------------------------------------------------------------------------
@@ -1950,6 +2045,7 @@ struct ImGuiMetricsConfig
     int         ShowTablesRectsType = -1;
     int         HighlightMonitorIdx = -1;
     ImGuiID     HighlightViewportID = 0;
+    char        TextEncodingViewerBuf[64] = "";
 };
 
 struct ImGuiStackLevelInfo
@@ -2107,12 +2203,12 @@ struct ImGuiContext
 
     // Shared stacks
     ImGuiCol                        DebugFlashStyleColorIdx;    // (Keep close to ColorStack to share cache line)
-    ImVector<ImGuiColorMod>         ColorStack;                 // Stack for PushStyleColor()/PopStyleColor() - inherited by Begin()
-    ImVector<ImGuiStyleMod>         StyleVarStack;              // Stack for PushStyleVar()/PopStyleVar() - inherited by Begin()
-    ImVector<ImFont*>               FontStack;                  // Stack for PushFont()/PopFont() - inherited by Begin()
+    ImSmallVector<ImGuiColorMod, 8> ColorStack;                 // Stack for PushStyleColor()/PopStyleColor() - inherited by Begin()
+    ImSmallVector<ImGuiStyleMod, 8> StyleVarStack;              // Stack for PushStyleVar()/PopStyleVar() - inherited by Begin()
+    ImSmallVector<ImFont*, 4>       FontStack;                  // Stack for PushFont()/PopFont() - inherited by Begin()
     ImVector<ImGuiFocusScopeData>   FocusScopeStack;            // Stack for PushFocusScope()/PopFocusScope() - inherited by BeginChild(), pushed into by Begin()
-    ImVector<ImGuiItemFlags>        ItemFlagsStack;             // Stack for PushItemFlag()/PopItemFlag() - inherited by Begin()
-    ImVector<ImGuiGroupData>        GroupStack;                 // Stack for BeginGroup()/EndGroup() - not inherited by Begin()
+    ImSmallVector<ImGuiItemFlags, 8> ItemFlagsStack;             // Stack for PushItemFlag()/PopItemFlag() - inherited by Begin()
+    ImSmallVector<ImGuiGroupData, 4> GroupStack;                 // Stack for BeginGroup()/EndGroup() - not inherited by Begin()
     ImVector<ImGuiPopupData>        OpenPopupStack;             // Which popups are open (persistent)
     ImVector<ImGuiPopupData>        BeginPopupStack;            // Which level of BeginPopup() we are in (reset every frame)
     ImVector<ImGuiTreeNodeStackData>TreeNodeStack;              // Stack for TreeNode()
@@ -2263,6 +2359,7 @@ struct ImGuiContext
     float                   ColorEditSavedSat;                  // Backup of last Saturation associated to LastColor, so we can restore Saturation in lossy RGB<>HSV round trips
     ImU32                   ColorEditSavedColor;                // RGB value with alpha set to 0.
     ImVec4                  ColorPickerRef;                     // Initial/reference color at the time of opening the color picker.
+    ImVector<ImGuiColorPickerWheelCache> ColorPickerWheelCache; // Hue wheel geometry of ColorPicker4(), for the last few sizes/styles used.
     ImGuiComboPreviewData   ComboPreviewData;
     ImRect                  WindowResizeBorderExpectedRect;     // Expected border rect, switch to relative edit if moving
     bool                    WindowResizeRelativeMode;
@@ -2290,9 +2387,17 @@ struct ImGuiContext
     bool                    SettingsLoaded;
     float                   SettingsDirtyTimer;                 // Save .ini Settings to memory when time reaches zero
     ImGuiTextBuffer         SettingsIniData;                    // In memory .ini settings
+    ImGuiTextBuffer         SettingsIniDataBinaryTemp;          // Output buffer when saving in binary format, swapped with SettingsIniData (which holds the blocks we are reusing)
     ImVector<ImGuiSettingsHandler>      SettingsHandlers;       // List of .ini settings handlers
+    ImGuiSettingsHandler*               SettingsHandlerWindow;  // = FindSettingsHandler("Window"), updated when SettingsHandlers[] changes
+    ImGuiSettingsHandler*               SettingsHandlerTable;   // = FindSettingsHandler("Table")
     ImChunkStream<ImGuiWindowSettings>  SettingsWindows;        // ImGuiWindow .ini settings entries
     ImChunkStream<ImGuiTableSettings>   SettingsTables;         // ImGuiTable .ini settings entries
+    ImGuiStorage                        SettingsWindowsMap;     // Map ID -> offset of latest entry in SettingsWindows (0 if none)
+    ImGuiStorage                        SettingsTablesMap;      // Map ID -> offset of latest entry in SettingsTables (0 if none)
+#ifdef IMGUI_ENABLE_ASYNC_INI_SAVING
+    ImGuiSettingsAsyncWriter*           SettingsAsyncWriter;    // Created on first use by SaveIniSettingsToDiskAsync()
+#endif
     ImVector<ImGuiContextHook>          Hooks;                  // Hooks for extensions (e.g. test engine)
     ImGuiID                             HookIdNext;             // Next available HookId
 
@@ -2343,6 +2448,14 @@ struct ImGuiContext
     ImVector<char>          TempBuffer;                         // Temporary text buffer
     char                    TempKeychordName[64];
 
+    // Allocator
+    ImGuiMemAllocFunc       AllocatorAllocFunc;                 // Used by MemAlloc()/MemFree() while this context is current. Set by CreateContext().
+    ImGuiMemFreeFunc        AllocatorFreeFunc;
+    void*                   AllocatorUserData;
+#ifdef IMGUI_ENABLE_FRAME_ARENA
+    ImFrameArena            FrameArena;                         // Storage for MemAllocTransient(), reset by NewFrame()
+#endif
+
     ImGuiContext(ImFontAtlas* shared_font_atlas)
     {
         IO.Ctx = this;
@@ -2352,7 +2465,7 @@ struct ImGuiContext
         FontAtlasOwnedByContext = shared_font_atlas ? false : true;
         Font = NULL;
         FontSize = FontBaseSize = FontScale = CurrentDpiScale = 0.0f;
-        IO.Fonts = shared_font_atlas ? shared_font_atlas : IM_NEW(ImFontAtlas)();
+        IO.Fonts = shared_font_atlas;                           // When NULL, CreateContext() creates an atlas once the context allocator is in use
         Time = 0.0f;
         FrameCount = 0;
         FrameCountEnded = FrameCountRendered = -1;
@@ -2507,6 +2620,10 @@ struct ImGuiContext
 
         SettingsLoaded = false;
         SettingsDirtyTimer = 0.0f;
+        SettingsHandlerWindow = SettingsHandlerTable = NULL;
+#ifdef IMGUI_ENABLE_ASYNC_INI_SAVING
+        SettingsAsyncWriter = NULL;
+#endif
         HookIdNext = 0;
 
         memset(LocalizationTable, 0, sizeof(LocalizationTable));
@@ -2544,6 +2661,10 @@ struct ImGuiContext
         FramerateSecPerFrameAccum = 0.0f;
         WantCaptureMouseNextFrame = WantCaptureKeyboardNextFrame = WantTextInputNextFrame = -1;
         memset(TempKeychordName, 0, sizeof(TempKeychordName));
+
+        AllocatorAllocFunc = NULL;
+        AllocatorFreeFunc = NULL;
+        AllocatorUserData = NULL;
     }
 };
 
@@ -2668,7 +2789,7 @@ struct IMGUI_API ImGuiWindow
     ImVec2                  SetWindowPosVal;                    // store window position when using a non-zero Pivot (position set needs to be processed when we know the window size)
     ImVec2                  SetWindowPosPivot;                  // store window pivot for positioning. ImVec2(0, 0) when positioning from top-left corner; ImVec2(0.5f, 0.5f) for centering; ImVec2(1, 1) for bottom right.
 
-    ImVector<ImGuiID>       IDStack;                            // ID stack. ID are hashes seeded with the value at the top of the stack. (In theory this should be in the TempData structure)
+    ImSmallVector<ImGuiID, 8> IDStack;                          // ID stack. ID are hashes seeded with the value at the top of the stack. (In theory this should be in the TempData structure)
     ImGuiWindowTempData     DC;                                 // Temporary per-window data, reset at the beginning of the frame. This used to be called ImGuiDrawContext, hence the "DC" variable name.
 
     // The best way to understand what those rectangles are is to use the 'Metrics->Tools->Show Windows Rectangles' viewer.
@@ -3176,6 +3297,11 @@ namespace ImGui
     // Settings
     IMGUI_API void                  MarkIniSettingsDirty();
     IMGUI_API void                  MarkIniSettingsDirty(ImGuiWindow* window);
+    IMGUI_API void                  MarkIniSettingsDirty(ImGuiSettingsHandler* handler);
+#ifdef IMGUI_ENABLE_ASYNC_INI_SAVING
+    IMGUI_API void                  SaveIniSettingsToDiskAsync(ImStrv ini_filename);    // Serialize settings now, write them to disk from a background thread. Used by NewFrame() for automatic saving.
+    IMGUI_API void                  FlushIniSettingsToDiskAsync();                       // Wait until pending background writes are completed.
+#endif
     IMGUI_API void                  ClearIniSettings();
     IMGUI_API void                  AddSettingsHandler(const ImGuiSettingsHandler* handler);
     IMGUI_API void                  RemoveSettingsHandler(ImStrv type_name);
@@ -3614,6 +3740,12 @@ namespace ImGui
     IMGUI_API void          ShadeVertsLinearUV(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, const ImVec2& a, const ImVec2& b, const ImVec2& uv_a, const ImVec2& uv_b, bool clamp);
     IMGUI_API void          ShadeVertsTransformPos(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, const ImVec2& pivot_in, float cos_a, float sin_a, const ImVec2& pivot_out);
 
+    // Transient allocations
+    // - Memory stays valid until MemFreeTransient() or the next NewFrame(), whichever comes first.
+    // - With IMGUI_ENABLE_FRAME_ARENA it is served by the context's frame arena and MemFreeTransient() does nothing, otherwise they call MemAlloc()/MemFree().
+    IMGUI_API void*         MemAllocTransient(size_t size);
+    IMGUI_API void          MemFreeTransient(void* ptr);
+
     // Garbage collection
     IMGUI_API void          GcCompactTransientMiscBuffers();
     IMGUI_API void          GcCompactTransientWindowBuffers(ImGuiWindow* window);
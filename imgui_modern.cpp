@@ -1,4 +1,13 @@
 #include "imgui_modern.h"
+#include <algorithm>
+#include <numeric>
+#include <ranges>
+#include <bit>
+#include <thread>
+#include <cstring>
+#include <unordered_map>
+#include <climits>
+#include <array>
 
 //#include <glm/vec2.hpp>
 
@@ -73,6 +82,43 @@ namespace ghassanpl::ig
 		return EditResult(result);
 	}
 
+	ImStrv VFormatToTempBuffer(std::string_view fmt, std::format_args args)
+	{
+		// Writes what fits and counts the rest, so that a text too long only costs a second pass once the buffer is grown
+		struct BoundedOutput
+		{
+			struct State
+			{
+				char* Out;
+				char* End;
+				size_t Count = 0;
+			};
+			using difference_type = ptrdiff_t;
+			State* Target;
+			BoundedOutput& operator*() { return *this; }
+			BoundedOutput& operator++() { return *this; }
+			BoundedOutput operator++(int) { return *this; }
+			BoundedOutput const& operator=(char c) const { if (Target->Out < Target->End) *Target->Out++ = c; Target->Count++; return *this; }
+		};
+
+		ImGuiContext& g = *GImGui;
+		ImVector<char>& buf = g.TempBuffer;
+		if (buf.Size < 2)
+			buf.resize(1024 * 3 + 1);
+		BoundedOutput::State state{ buf.Data, buf.Data + buf.Size - 1 };
+		std::vformat_to(BoundedOutput{ &state }, fmt, args);
+		const size_t count = state.Count;
+		if (count >= (size_t)buf.Size)
+		{
+			IM_ASSERT(count < INT_MAX);
+			buf.resize((int)count + 1);
+			state = { buf.Data, buf.Data + buf.Size - 1 };
+			std::vformat_to(BoundedOutput{ &state }, fmt, args);
+		}
+		buf.Data[count] = 0;
+		return ImStrv{ buf.Data, buf.Data + count };
+	}
+
 	bool WrapIfNoRoomFor(float min_width)
 	{
 		ImGuiContext& g = *GImGui;
@@ -96,7 +142,36 @@ namespace ghassanpl::ig
 		return WrapIfNoRoomFor(ImGui::CalcTextSize(label.data()).x + ImGui::GetStyle().ItemSpacing.x + ImGui::GetStyle().FramePadding.x * 2 + plus);
 	}
 
-	static ImVector<ImRect> s_GroupPanelLabelStack;
+	/// State of widgets below kept per ImGuiContext (the current one if `ctx` is null): created on first use, and destroyed with the context
+	/// by a shutdown hook owning it. `owner` tells the states apart among the context's hooks.
+	template <typename T>
+	static T& ContextState(ImGuiID owner, ImGuiContext* ctx = nullptr)
+	{
+		ImGuiContext& g = ctx ? *ctx : *GImGui;
+		for (ImGuiContextHook const& hook : g.Hooks)
+			if (hook.Type == ImGuiContextHookType_Shutdown && hook.Owner == owner)
+				return *(T*)hook.UserData;
+
+		ImGuiContextHook hook;
+		hook.Type = ImGuiContextHookType_Shutdown;
+		hook.Owner = owner;
+		hook.Callback = [](ImGuiContext*, ImGuiContextHook* hook) { delete (T*)hook->UserData; hook->UserData = nullptr; };
+		hook.UserData = new T{};
+		ImGui::AddContextHook(&g, &hook);
+		return *(T*)hook.UserData;
+	}
+
+	/// Label rects of the group panels being submitted, per context
+	struct GroupPanelState
+	{
+		ImVector<ImRect> LabelStack;
+	};
+
+	static GroupPanelState& GetGroupPanelState()
+	{
+		static const ImGuiID owner = ImHashStr("ig::GroupPanel");
+		return ContextState<GroupPanelState>(owner);
+	}
 
 	void BeginGroupPanel(std::string_view name, const ImVec2& size)
 	{
@@ -145,7 +220,7 @@ namespace ghassanpl::ig
 		auto itemWidth = ImGui::CalcItemWidth();
 		ImGui::PushItemWidth(ImMax(0.0f, itemWidth - frameHeight));
 
-		s_GroupPanelLabelStack.push_back(ImRect(labelMin, labelMax));
+		GetGroupPanelState().LabelStack.push_back(ImRect(labelMin, labelMax));
 	}
 
 	void EndGroupPanel()
@@ -175,8 +250,9 @@ namespace ghassanpl::ig
 		auto itemMax = ImGui::GetItemRectMax();
 		//ImGui::GetWindowDrawList()->AddRectFilled(itemMin, itemMax, IM_COL32(255, 0, 0, 64), 4.0f);
 
-		auto labelRect = s_GroupPanelLabelStack.back();
-		s_GroupPanelLabelStack.pop_back();
+		auto& labelStack = GetGroupPanelState().LabelStack;
+		auto labelRect = labelStack.back();
+		labelStack.pop_back();
 
 		ImVec2 halfFrame = ImVec2(frameHeight * 0.25f, frameHeight) * 0.5f;
 		ImRect frameRect = ImRect(itemMin + halfFrame, itemMax - ImVec2(halfFrame.x, 0.0f));
@@ -220,136 +296,6 @@ namespace ghassanpl::ig
 		ImGui::EndGroup();
 	}
 
-	/*
-	static std::vector<Toast> mToasts;
-
-	/// <summary>
-	/// Insert a new toast in the list
-	/// </summary>
-	size_t PushToast(Toast toast)
-	{
-		mToasts.push_back(std::move(toast));
-		return mToasts.size() - 1;
-	}
-
-
-	/// <summary>
-	/// Remove a toast from the list by its index
-	/// </summary>
-	/// <param name="index">index of the toast to remove</param>
-	void RemoveToast(size_t index)
-	{
-		mToasts.erase(mToasts.begin() + index);
-	}
-
-	/// <summary>
-	/// Render toasts, call at the end of your rendering!
-	/// </summary>
-	void RenderToasts()
-	{
-		using namespace ImGui;
-		const auto vp_size = GetMainViewport()->Size;
-
-		float height = 0.f;
-
-		auto now = std::chrono::system_clock::now();
-
-		for (auto i = 0; i < mToasts.size(); i++)
-		{
-			auto* current_toast = &mToasts[i];
-
-			current_toast->Update(now);
-
-			// Get icon, title and other data
-			const auto& icon = current_toast->icon;
-			const auto& title = current_toast->title;
-			const auto& content_string = current_toast->content_string;
-			const auto& content_func = current_toast->content_func;
-			const auto has_content = !content_string.empty() || content_func;
-			const auto default_title = current_toast->DefaultTitle();
-			const auto opacity = (float)current_toast->FadePercent(); // Get opacity based of the current phase
-
-			auto text_color = current_toast->Color();
-			text_color.w = opacity;
-
-			// Generate new unique name for this toast
-			auto window_name = std::format("##TOAST{}", i);
-
-			//PushStyleColor(ImGuiCol_Text, text_color);
-			SetNextWindowBgAlpha(opacity);
-			SetNextWindowPos(ImVec2(vp_size.x - ToastPadding.x, vp_size.y - ToastPadding.y - height), ImGuiCond_Always, ImVec2(1.0f, 1.0f));
-			Begin(window_name.c_str(), NULL, current_toast->WindowFlags | ImGuiWindowFlags_NoSavedSettings);
-			BringWindowToDisplayFront(ImGui::GetCurrentWindow()); // needs imgui_internal.h
-
-			// Here we render the toast content
-			{
-				PushTextWrapPos(vp_size.x / 3.f); // We want to support multi-line text, this will wrap the text after 1/3 of the screen width
-
-				bool was_title_rendered = false;
-
-				// If an icon is set
-				if (!icon.empty())
-				{
-					//Text(icon); // Render icon text
-					TextColored(text_color, icon.c_str());
-					was_title_rendered = true;
-				}
-
-				// If a title is set
-				if (!title.empty())
-				{
-					// If a title and an icon is set, we want to render on same line
-					if (!icon.empty())
-						SameLine();
-
-					TextUnformatted(ImStrv{ title }); // Render title text
-					was_title_rendered = true;
-				}
-				else if (!default_title.empty())
-				{
-					if (!icon.empty())
-						SameLine();
-
-					Text(default_title.data(), default_title.data() + default_title.size()); // Render default title text (ImGuiToastType_Success -> "Success", etc...)
-					was_title_rendered = true;
-				}
-
-				// In case ANYTHING was rendered in the top, we want to add a small padding so the text (or icon) looks centered vertically
-				if (was_title_rendered && has_content)
-				{
-					SetCursorPosY(GetCursorPosY() + 5.f); // Must be a better way to do this!!!!
-				}
-
-				// If a content is set
-				if (has_content)
-				{
-					if (was_title_rendered && current_toast->Separator)
-						Separator();
-
-					if (!content_string.empty())
-						TextUnformatted(ImStrv{ content_string }); // Render content text
-					else
-					{
-						bool close = content_func(*current_toast);
-						if (close)
-							current_toast->SetPhase(ToastPhase::Expired);
-					}
-				}
-
-				PopTextWrapPos();
-			}
-
-			// Save height for next toasts
-			height += GetWindowHeight() + ToastSpacing;
-
-			// End
-			End();
-		}
-
-		std::erase_if(mToasts, [](auto& toast) { return toast.Phase() == ToastPhase::Expired; });
-	}
-	*/
-
 	bool VerticalToolbar(std::span<std::pair<std::string_view, std::string_view>const> const items, int& item_index)
 	{
 		bool value_changed = false;
@@ -367,10 +313,10 @@ namespace ghassanpl::ig
 		return value_changed;
 	}
 
-	static int propose(ImGuiInputTextCallbackData* data, std::span<std::string_view> items)
+	static int propose(ImGuiInputTextCallbackData* data, FuzzyIndex& items)
 	{
 		//We don't want to "preselect" anything
-		if (strlen(data->Buf) == 0) return 0;
+		if (data->BufTextLen == 0) return 0;
 
 		//Get our items back
 		//const char** items = static_cast<std::pair<const char**, size_t>*> (data->UserData)->first;
@@ -391,30 +337,114 @@ namespace ghassanpl::ig
 		if (key == sf::Keyboard::Key::Delete) return 0; //TODO: Replace with imgui key
 		*/
 
-		for (auto& item : items)
+		auto matches = items.WithPrefix(std::string_view{ data->Buf, (size_t)data->BufTextLen });
+		if (!matches.empty())
 		{
-			if (item.starts_with(data->Buf))
-			{
-				const int cursor = data->CursorPos;
-				//Insert the first match
-				data->DeleteChars(0, data->BufTextLen);
-				data->InsertChars(0, item);
-				//Reset the cursor position
-				data->CursorPos = cursor;
-				//Select the text, so the user can simply go on writing
-				data->SelectionStart = cursor;
-				data->SelectionEnd = data->BufTextLen;
-				break;
-			}
+			const auto item = items.Item(matches.front());
+			const int cursor = data->CursorPos;
+			//Insert the first match
+			data->DeleteChars(0, data->BufTextLen);
+			data->InsertChars(0, item);
+			//Reset the cursor position
+			data->CursorPos = cursor;
+			//Select the text, so the user can simply go on writing
+			data->SelectionStart = cursor;
+			data->SelectionEnd = data->BufTextLen;
 		}
 		return 0;
 	}
 
+	/// State of TextInputComboBox() widgets, per widget ID
+	struct TextInputComboBoxStates
+	{
+		struct Entry
+		{
+			double LastTimeUsed = 0.0;
+			int LastInUseFrame = -2;	/// Last frame the input was active or the popup open
+			std::string Filter;			/// Text typed in the popup
+
+			/// Span overload only: the index of the items, and what it was built from
+			const void* ItemsData = nullptr;
+			size_t ItemsSize = 0;
+			ImGuiID ItemsHash = 0;		/// Of the views and their contents
+			FuzzyIndex Index;
+		};
+		std::unordered_map<ImGuiID, Entry> Entries;
+		int LastGcFrame = -1;
+	};
+
+	static TextInputComboBoxStates::Entry& GetTextInputComboBoxState(ImStrv id)
+	{
+		ImGuiContext& g = *GImGui;
+		static const ImGuiID owner = ImHashStr("ig::TextInputComboBox");
+		auto& states = ContextState<TextInputComboBoxStates>(owner);
+
+		// Drop the states of combo boxes not shown lately, like the core does with tables (see TableGcCompactTransientBuffers())
+		if (states.LastGcFrame != g.FrameCount && g.IO.ConfigMemoryCompactTimer >= 0.0f)
+		{
+			states.LastGcFrame = g.FrameCount;
+			const double gc_time = g.Time - g.IO.ConfigMemoryCompactTimer;
+			std::erase_if(states.Entries, [&](auto const& entry) { return entry.second.LastTimeUsed < gc_time; });
+		}
+
+		auto& state = states.Entries[ImGui::GetID(id)];
+		state.LastTimeUsed = g.Time;
+		return state;
+	}
+
+	static ImGuiID HashItems(std::span<std::string_view> items)
+	{
+		ImGuiID hash = (ImGuiID)items.size();
+		for (std::string_view const& item : items)
+		{
+			hash = ImHashData(&item, sizeof(item), hash);
+			hash = ImHashData(item.data(), item.size(), hash);
+		}
+		return hash;
+	}
+
+	/// Called while the widget is in use. When it was not in use the frame before, rebuilds the index of `items` if they were edited in place since.
+	static void TextInputComboBoxInUse(TextInputComboBoxStates::Entry& state, std::span<std::string_view> const* items)
+	{
+		ImGuiContext& g = *GImGui;
+		const bool was_in_use = state.LastInUseFrame >= g.FrameCount - 1;
+		state.LastInUseFrame = g.FrameCount;
+		if (was_in_use || items == nullptr)
+			return;
+		if (const ImGuiID items_hash = HashItems(*items); items_hash != state.ItemsHash)
+		{
+			state.Index.Build(*items);
+			state.ItemsHash = items_hash;
+		}
+	}
+
+	static bool TextInputComboBox(ImStrv id, std::string& str, FuzzyIndex& items, short showMaxItems, TextInputComboBoxStates::Entry& state, std::span<std::string_view> const* source);
+
 	bool TextInputComboBox(ImStrv id, std::string& str, std::span<std::string_view> items, short showMaxItems)
+	{
+		// The index views the span: it is built again when the span changes. Edits made in place are only looked for when the widget
+		// starts being used (input activated or popup opened), so that idle widgets cost nothing per item.
+		auto& state = GetTextInputComboBoxState(id);
+		if (state.ItemsData != items.data() || state.ItemsSize != items.size())
+		{
+			state.Index.Build(items);
+			state.ItemsData = items.data();
+			state.ItemsSize = items.size();
+			state.ItemsHash = HashItems(items);
+		}
+		return TextInputComboBox(id, str, state.Index, showMaxItems, state, &items);
+	}
+
+	bool TextInputComboBox(ImStrv id, std::string& str, FuzzyIndex& items, short showMaxItems)
+	{
+		return TextInputComboBox(id, str, items, showMaxItems, GetTextInputComboBoxState(id), nullptr);
+	}
+
+	static bool TextInputComboBox(ImStrv id, std::string& str, FuzzyIndex& items, short showMaxItems, TextInputComboBoxStates::Entry& state, std::span<std::string_view> const* source)
 	{
 		//Check if both strings matches
 		if (showMaxItems == 0)
-			showMaxItems = items.size();
+			showMaxItems = (short)std::min<size_t>(items.Size(), SHRT_MAX);
 
 		ig::ID _(id);
 		ValueColumn(id);
@@ -422,6 +452,8 @@ namespace ghassanpl::ig
 		bool ret = ig::InputText(id_label{ "##in" }, str,
 			[&](ImGuiInputTextCallbackData& data) { return propose(&data, items); },
 			{ InputTextFlags::CallbackAlways, InputTextFlags::EnterReturnsTrue });
+		if (ImGui::IsItemActive())
+			TextInputComboBoxInUse(state, source);
 
 		ImGui::OpenPopupOnItemClick("combobox"); //Enable right-click
 		ImVec2 pos = ImGui::GetItemRectMin();
@@ -439,19 +471,41 @@ namespace ghassanpl::ig
 		ImGui::SetNextWindowPos(pos);
 		ImGui::SetNextWindowSize(size);
 		if (ImGui::BeginPopup("combobox", ImGuiWindowFlags_::ImGuiWindowFlags_NoMove)) {
+			TextInputComboBoxInUse(state, source);
 
 			//ImGui::Text("Select one item or type");
-			static std::string filter;
+			auto& filter = state.Filter;
 			ig::InputText("Filter", filter);
 			ImGui::Separator();
-			for (auto& item : items)
-			{
-				if (item.empty()) continue;
+
+			auto select = [&](std::string_view item) {
+				if (item.empty()) return;
 				if (ImGui::Selectable(item))
 				{
 					str.assign_range(item);
 					ret = true;
 				}
+			};
+
+			// Only the visible items are submitted; when filtering, the best matches first
+			constexpr size_t max_filtered_items = 1000;
+			ImGuiListClipper clipper;
+			if (filter.empty())
+			{
+				clipper.Begin((int)items.Size());
+				while (clipper.Step())
+					for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+						select(items.Item(i));
+			}
+			else
+			{
+				auto matches = items.SearchBest(filter, max_filtered_items);
+				clipper.Begin((int)matches.size());
+				while (clipper.Step())
+					for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+						select(items.Item(matches[i].Item));
+				if (const size_t total = items.Search(filter).size(); total > matches.size())
+					ImGui::TextDisabled("(%d more)", (int)(total - matches.size()));
 			}
 
 			ImGui::EndPopup();
@@ -460,6 +514,2086 @@ namespace ghassanpl::ig
 		return ret;
 	}
 
+	void TableSortEngine::SetRowCount(size_t count)
+	{
+		mIndices.resize(count);
+		std::iota(mIndices.begin(), mIndices.end(), size_t{});
+		mNeedsFullSort = true;
+	}
+
+	int TableSortEngine::SortKey::Compare(size_t a, size_t b) const noexcept
+	{
+		if (!Ints.empty())
+			return (Ints[a] > Ints[b]) - (Ints[a] < Ints[b]);
+		if (!Floats.empty())
+			return (Floats[a] > Floats[b]) - (Floats[a] < Floats[b]);
+		if (!Strings.empty())
+			return Strings[a].compare(Strings[b]);
+		return 0;
+	}
+
+	bool TableSortEngine::Sort(ImGuiTableSortSpecs* specs)
+	{
+		if (specs == nullptr || (!specs->SpecsDirty && !mNeedsFullSort))
+			return false;
+		specs->SpecsDirty = false;
+
+		// Only keep specs for columns we have keys for
+		std::vector<std::pair<int, ImGuiSortDirection>> requested;
+		for (int n = 0; n < specs->SpecsCount; n++)
+		{
+			auto const& spec = specs->Specs[n];
+			if (spec.ColumnIndex < (int)mExtractors.size() && mExtractors[spec.ColumnIndex] && spec.SortDirection != ImGuiSortDirection_None)
+				requested.emplace_back(spec.ColumnIndex, spec.SortDirection);
+		}
+
+		const bool same_columns = requested.size() == mKeys.size() && std::ranges::equal(requested, mKeys, [](auto const& req, SortKey const& key) { return req.first == key.ColumnIndex; });
+		if (!mNeedsFullSort && same_columns)
+		{
+			const bool same_secondary = std::ranges::equal(requested | std::views::drop(1), mKeys | std::views::drop(1), [](auto const& req, SortKey const& key) { return req.second == key.Direction; });
+			if (!requested.empty() && same_secondary && requested[0].second != mKeys[0].Direction)
+			{
+				FlipPrimaryDirection();
+				return true;
+			}
+			if (requested.empty() || (same_secondary && requested[0].second == mKeys[0].Direction))
+				return false;
+		}
+
+		mKeys.resize(requested.size());
+		for (size_t k = 0; k < requested.size(); k++)
+		{
+			mKeys[k].ColumnIndex = requested[k].first;
+			mKeys[k].Direction = requested[k].second;
+		}
+		FullSort();
+		return true;
+	}
+
+	/// With TableSortEngine::Parallel, work is split into contiguous chunks of at least this many items, one thread per chunk
+	static constexpr size_t SortMinChunkSize = 64 * 1024;
+
+	static size_t SortChunkCount(bool parallel, size_t count)
+	{
+		const size_t max_chunks = parallel ? std::max(1u, std::thread::hardware_concurrency()) : 1;
+		return std::clamp<size_t>(count / SortMinChunkSize, 1, max_chunks);
+	}
+
+	/// Calls `func(task)` for each task in [0, task_count), each on its own thread, the first one on the calling thread.
+	/// Like TextFilterIndex, threads are started per call, which is negligible next to the work handed to them.
+	template <typename FUNC>
+	static void RunOnThreads(size_t task_count, FUNC&& func)
+	{
+		std::vector<std::jthread> threads;
+		threads.reserve(task_count > 0 ? task_count - 1 : 0);
+		for (size_t task = 1; task < task_count; task++)
+			threads.emplace_back([&func, task] { func(task); });
+		if (task_count > 0)
+			func(size_t{ 0 });
+	}
+
+	/// Calls `func(chunk, first, last)` for `chunk_count` contiguous ranges covering [0, count), each on its own thread
+	template <typename FUNC>
+	static void ForEachChunk(size_t chunk_count, size_t count, FUNC&& func)
+	{
+		RunOnThreads(chunk_count, [&](size_t chunk) { func(chunk, count * chunk / chunk_count, count * (chunk + 1) / chunk_count); });
+	}
+
+	/// Maps keys to unsigned integers with the same ordering, for radix sorting
+	static uint64_t RadixSortableBits(int64_t value) noexcept { return uint64_t(value) ^ (uint64_t(1) << 63); }
+	static uint64_t RadixSortableBits(double value) noexcept
+	{
+		const auto bits = std::bit_cast<uint64_t>(value);
+		return (bits >> 63) ? ~bits : (bits | (uint64_t(1) << 63));
+	}
+
+	struct RadixSortEntry
+	{
+		uint64_t Key;
+		size_t Index;
+	};
+
+	/// Stable LSD radix sort, skipping passes where all entries share the same digit.
+	/// In parallel, each pass counts and scatters contiguous chunks on their own thread: chunk c writes each digit's entries
+	/// after those of chunks [0, c), which keeps the sort stable.
+	static void RadixSort(bool parallel, std::vector<RadixSortEntry>& entries)
+	{
+		const size_t chunk_count = SortChunkCount(parallel, entries.size());
+		std::vector<RadixSortEntry> temp(entries.size());
+		std::vector<std::array<size_t, 256>> offsets(chunk_count);
+		for (int shift = 0; shift < 64; shift += 8)
+		{
+			ForEachChunk(chunk_count, entries.size(), [&](size_t chunk, size_t first, size_t last) {
+				auto& chunk_offsets = offsets[chunk];
+				chunk_offsets.fill(0);
+				for (size_t i = first; i < last; i++)
+					++chunk_offsets[(entries[i].Key >> shift) & 0xFF];
+			});
+
+			bool single_digit = false;
+			size_t sum = 0;
+			for (size_t digit = 0; digit < 256 && !single_digit; digit++)
+			{
+				const size_t digit_start = sum;
+				for (auto& chunk_offsets : offsets)
+					sum += std::exchange(chunk_offsets[digit], sum);
+				single_digit = (sum - digit_start == entries.size());
+			}
+			if (single_digit)
+				continue;
+
+			ForEachChunk(chunk_count, entries.size(), [&](size_t chunk, size_t first, size_t last) {
+				auto& chunk_offsets = offsets[chunk];
+				for (size_t i = first; i < last; i++)
+					temp[chunk_offsets[(entries[i].Key >> shift) & 0xFF]++] = entries[i];
+			});
+			entries.swap(temp);
+		}
+	}
+
+	/// Stable merge sort: in parallel, chunks are sorted on their own thread, then adjacent ones merged pairwise, each level's merges on their own thread
+	template <typename T, typename LESS>
+	static void ParallelStableSort(bool parallel, std::vector<T>& entries, LESS&& less)
+	{
+		const size_t chunk_count = SortChunkCount(parallel, entries.size());
+		const auto chunk_begin = [&](size_t chunk) { return entries.begin() + entries.size() * chunk / chunk_count; };
+		ForEachChunk(chunk_count, entries.size(), [&](size_t, size_t first, size_t last) {
+			std::stable_sort(entries.begin() + first, entries.begin() + last, less);
+		});
+		for (size_t width = 1; width < chunk_count; width *= 2)
+		{
+			RunOnThreads((chunk_count + width * 2 - 1) / (width * 2), [&](size_t merge) {
+				const size_t first = merge * width * 2;
+				std::inplace_merge(chunk_begin(first), chunk_begin(std::min(first + width, chunk_count)), chunk_begin(std::min(first + width * 2, chunk_count)), less);
+			});
+		}
+	}
+
+	/// Sorts `indices` by keys[key_index], then each run of equal keys by the following keys.
+	/// Keys are copied next to their row index before sorting so comparisons stay cache friendly.
+	static void SortByKeys(bool parallel, std::span<TableSortEngine::SortKey const> keys, std::span<size_t> indices, size_t key_index)
+	{
+		auto const& key = keys[key_index];
+		const bool descending = (key.Direction == ImGuiSortDirection_Descending);
+		std::vector<std::pair<size_t, size_t>> tied_runs;
+		auto const collect_tied_runs = [&](auto const& entries, auto&& equal) {
+			for (size_t run_start = 0; run_start < entries.size(); )
+			{
+				size_t run_end = run_start + 1;
+				while (run_end < entries.size() && equal(entries[run_start], entries[run_end]))
+					++run_end;
+				if (run_end - run_start > 1)
+					tied_runs.emplace_back(run_start, run_end);
+				run_start = run_end;
+			}
+		};
+
+		if (key.Strings.empty())
+		{
+			const uint64_t direction_mask = descending ? ~uint64_t{} : 0;
+			std::vector<RadixSortEntry> entries(indices.size());
+			ForEachChunk(SortChunkCount(parallel, indices.size()), indices.size(), [&](size_t, size_t first, size_t last) {
+				for (size_t i = first; i < last; i++)
+				{
+					const size_t index = indices[i];
+					entries[i] = { (key.Ints.empty() ? RadixSortableBits(key.Floats[index]) : RadixSortableBits(key.Ints[index])) ^ direction_mask, index };
+				}
+			});
+			if (entries.size() >= 256)
+				RadixSort(parallel, entries);
+			else
+				std::stable_sort(entries.begin(), entries.end(), [](RadixSortEntry const& a, RadixSortEntry const& b) { return a.Key < b.Key; });
+			for (size_t i = 0; i < indices.size(); i++)
+				indices[i] = entries[i].Index;
+			if (key_index + 1 < keys.size())
+				collect_tied_runs(entries, [](RadixSortEntry const& a, RadixSortEntry const& b) { return a.Key == b.Key; });
+		}
+		else
+		{
+			std::vector<std::pair<std::string_view, size_t>> entries(indices.size());
+			for (size_t i = 0; i < indices.size(); i++)
+				entries[i] = { key.Strings[indices[i]], indices[i] };
+			ParallelStableSort(parallel, entries, [descending](auto const& a, auto const& b) { return descending ? a.first > b.first : a.first < b.first; });
+			for (size_t i = 0; i < indices.size(); i++)
+				indices[i] = entries[i].second;
+			if (key_index + 1 < keys.size())
+				collect_tied_runs(entries, [](auto const& a, auto const& b) { return a.first == b.first; });
+		}
+
+		// Runs are spread over the threads in contiguous groups, each sorted sequentially
+		const size_t run_chunk_count = std::min(SortChunkCount(parallel, indices.size()), std::max<size_t>(tied_runs.size(), 1));
+		ForEachChunk(run_chunk_count, tied_runs.size(), [&](size_t, size_t first, size_t last) {
+			for (size_t i = first; i < last; i++)
+				SortByKeys(false, keys, indices.subspan(tied_runs[i].first, tied_runs[i].second - tied_runs[i].first), key_index + 1);
+		});
+	}
+
+	void TableSortEngine::FullSort()
+	{
+		mNeedsFullSort = false;
+		const size_t count = mIndices.size();
+		std::iota(mIndices.begin(), mIndices.end(), size_t{});
+
+		// Extract keys once, so sorting never calls back into the application
+		const size_t chunk_count = SortChunkCount(Parallel, count);
+		const auto extract = [&](auto& out, auto const& extract_key) {
+			out.resize(count);
+			ForEachChunk(chunk_count, count, [&](size_t, size_t first, size_t last) {
+				for (size_t i = first; i < last; i++)
+					out[i] = extract_key(mIndices[i]);
+			});
+		};
+		for (auto& key : mKeys)
+		{
+			auto const& extractor = mExtractors[key.ColumnIndex];
+			key.Ints.clear();
+			key.Floats.clear();
+			key.Strings.clear();
+			key.OwnedStrings.clear();
+			if (extractor.Int)
+				extract(key.Ints, extractor.Int);
+			else if (extractor.Float)
+				extract(key.Floats, extractor.Float);
+			else if (extractor.OwnedString)
+			{
+				extract(key.OwnedStrings, extractor.OwnedString);
+				key.Strings.assign(key.OwnedStrings.begin(), key.OwnedStrings.end());
+			}
+			else
+				extract(key.Strings, extractor.String);
+		}
+
+		if (!mKeys.empty() && count > 1)
+			SortByKeys(Parallel, std::span<SortKey const>{ mKeys }, std::span<size_t>{ mIndices }, 0);
+	}
+
+	void TableSortEngine::FlipPrimaryDirection()
+	{
+		auto& primary = mKeys[0];
+		primary.Direction = (primary.Direction == ImGuiSortDirection_Ascending) ? ImGuiSortDirection_Descending : ImGuiSortDirection_Ascending;
+
+		// Reversing the permutation also reverses runs of equal primary keys; reverse those back to keep them ordered by the secondary keys (and stable)
+		std::reverse(mIndices.begin(), mIndices.end());
+		for (size_t run_start = 0; run_start < mIndices.size(); )
+		{
+			size_t run_end = run_start + 1;
+			while (run_end < mIndices.size() && primary.Compare(mIndices[run_start], mIndices[run_end]) == 0)
+				++run_end;
+			std::reverse(mIndices.begin() + run_start, mIndices.begin() + run_end);
+			run_start = run_end;
+		}
+	}
+
+	void TextFilterIndex::Clear()
+	{
+		mLines.clear();
+		mTestedLines = 0;
+		mLastLinePasses = false;
+	}
+
+	bool TextFilterIndex::Update(ImGuiTextFilter const& filter, const char* buf, ImGuiTextIndex& line_index)
+	{
+		const int line_count = line_index.size();
+		const bool last_line_complete = line_index.EndOffset == 0 || buf[line_index.EndOffset - 1] == '\n';
+		const int complete_lines = last_line_complete ? line_count : line_count - 1;
+		IM_ASSERT(mTestedLines <= complete_lines && "Buffer was cleared without calling TextFilterIndex::Clear()");
+
+		const int old_size = Size();
+		const bool old_last_line_passes = mLastLinePasses;
+		if (mFilterText != filter.InputBuf)
+		{
+			mFilterText = filter.InputBuf;
+			mPassAll = !filter.IsActive();
+			if (mPassAll)
+			{
+				mLines.clear();
+				mTestedLines = complete_lines;
+			}
+			else
+				Rebuild(filter, buf, line_index, complete_lines);
+		}
+		else if (mPassAll)
+			mTestedLines = complete_lines;
+		else
+		{
+			for (; mTestedLines < complete_lines; mTestedLines++)
+				if (filter.PassFilter(ImStrv{ line_index.get_line_begin(buf, mTestedLines), line_index.get_line_end(buf, mTestedLines) }))
+					mLines.push_back(mTestedLines);
+		}
+
+		mLastLinePasses = complete_lines < line_count && filter.PassFilter(ImStrv{ line_index.get_line_begin(buf, complete_lines), line_index.get_line_end(buf, complete_lines) });
+		return Size() != old_size || mLastLinePasses != old_last_line_passes;
+	}
+
+	void TextFilterIndex::Rebuild(ImGuiTextFilter const& filter, const char* buf, ImGuiTextIndex& line_index, int complete_lines)
+	{
+		mLines.clear();
+		mTestedLines = complete_lines;
+
+		const int max_threads = (int)(ThreadCount ? ThreadCount : std::max(1u, std::thread::hardware_concurrency()));
+		const int thread_count = std::clamp(complete_lines / std::max(1, MinLinesPerThread), 1, max_threads);
+		if (thread_count == 1)
+		{
+			for (int line = 0; line < complete_lines; line++)
+				if (filter.PassFilter(ImStrv{ line_index.get_line_begin(buf, line), line_index.get_line_end(buf, line) }))
+					mLines.push_back(line);
+			return;
+		}
+
+		// Each thread filters a contiguous range of lines into its own vector (workers must not touch ImGui allocations), concatenated in order afterwards
+		std::vector<std::vector<int>> passed(thread_count);
+		{
+			std::vector<std::jthread> threads;
+			threads.reserve(thread_count);
+			for (int t = 0; t < thread_count; t++)
+			{
+				const int first = (int)((int64_t)complete_lines * t / thread_count);
+				const int last = (int)((int64_t)complete_lines * (t + 1) / thread_count);
+				threads.emplace_back([&, first, last, out = &passed[t]] {
+					for (int line = first; line < last; line++)
+						if (filter.PassFilter(ImStrv{ line_index.get_line_begin(buf, line), line_index.get_line_end(buf, line) }))
+							out->push_back(line);
+				});
+			}
+		}
+		size_t total = 0;
+		for (auto const& lines : passed)
+			total += lines.size();
+		mLines.reserve(total);
+		for (auto const& lines : passed)
+			mLines.insert(mLines.end(), lines.begin(), lines.end());
+	}
+
+	static char FuzzyFoldCase(char c) noexcept
+	{
+		return (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+	}
+
+	static uint64_t FuzzyCharMask(std::string_view text) noexcept
+	{
+		// One bit per letter (case-insensitive) and digit, the other characters share the remaining 28 bits
+		uint64_t mask = 0;
+		for (char c : text)
+		{
+			c = FuzzyFoldCase(c);
+			const unsigned bit = (c >= 'a' && c <= 'z') ? (unsigned)(c - 'a') : (c >= '0' && c <= '9') ? 26 + (unsigned)(c - '0') : 36 + (unsigned)(uint8_t)c % 28;
+			mask |= uint64_t{ 1 } << bit;
+		}
+		return mask;
+	}
+
+	void FuzzyIndex::Build(std::span<std::string_view const> items)
+	{
+		IM_ASSERT(items.size() <= UINT32_MAX);
+		mOwnedViews.clear();
+		mItems = items;
+		mMasks.resize(items.size());
+		for (size_t i = 0; i < items.size(); i++)
+			mMasks[i] = FuzzyCharMask(items[i]);
+		mSorted.clear();
+		mQuery.clear();
+		mMatches.clear();
+		mBest.clear();
+		mQueryValid = false;
+	}
+
+	void FuzzyIndex::Append(std::span<std::string_view const> items)
+	{
+		IM_ASSERT(mItems.size() + items.size() <= UINT32_MAX);
+		if (mItems.data() != mOwnedViews.data() || mItems.size() != mOwnedViews.size())
+			mOwnedViews.assign(mItems.begin(), mItems.end()); // Built over the caller's span
+		const size_t first = mOwnedViews.size();
+		mOwnedViews.insert(mOwnedViews.end(), items.begin(), items.end());
+		mItems = mOwnedViews;
+		mMasks.resize(mItems.size());
+		for (size_t i = first; i < mItems.size(); i++)
+			mMasks[i] = FuzzyCharMask(mItems[i]);
+
+		// Matches stay in item order: the new items go after the previous matches
+		if (mQueryValid && !mQuery.empty())
+		{
+			const uint64_t query_mask = FuzzyCharMask(mQuery);
+			for (size_t i = first; i < mItems.size(); i++)
+				if ((mMasks[i] & query_mask) == query_mask)
+					if (const int score = FuzzyScore(mQuery, mItems[i]); score >= 0)
+						mMatches.push_back({ (uint32_t)i, score });
+		}
+		mBest.clear();
+	}
+
+	void FuzzyIndex::Clear()
+	{
+		Build({});
+	}
+
+	std::span<uint32_t const> FuzzyIndex::WithPrefix(std::string_view prefix)
+	{
+		if (mSorted.size() != mItems.size())
+		{
+			// Sorted next to their index, so comparisons don't go through mItems
+			std::vector<std::pair<std::string_view, uint32_t>> sorted(mItems.size());
+			for (size_t i = 0; i < mItems.size(); i++)
+				sorted[i] = { mItems[i], (uint32_t)i };
+			std::sort(sorted.begin(), sorted.end());
+			mSorted.resize(sorted.size());
+			for (size_t i = 0; i < sorted.size(); i++)
+				mSorted[i] = sorted[i].second;
+		}
+
+		const auto first = std::lower_bound(mSorted.begin(), mSorted.end(), prefix, [this](uint32_t item, std::string_view prefix) { return mItems[item] < prefix; });
+		const auto last = std::partition_point(first, mSorted.end(), [&](uint32_t item) { return mItems[item].starts_with(prefix); });
+		return { first, last };
+	}
+
+	int FuzzyIndex::FuzzyScore(std::string_view query, std::string_view text)
+	{
+		constexpr int score_match = 16;
+		constexpr int bonus_consecutive = 24;
+		constexpr int bonus_first_char = 32;
+		constexpr int bonus_word_start = 20;
+		constexpr int max_gap_penalty = 12;
+
+		auto const is_word_start = [&](size_t i) {
+			if (i == 0) return true;
+			const char prev = text[i - 1], cur = text[i];
+			return prev == ' ' || prev == '_' || prev == '-' || prev == '.' || prev == '/' || prev == '\\' || (prev >= 'a' && prev <= 'z' && cur >= 'A' && cur <= 'Z');
+		};
+
+		// Greedy, leftmost match of each query character
+		int score = 0;
+		size_t t = 0, prev = std::string_view::npos;
+		for (char qc : query)
+		{
+			qc = FuzzyFoldCase(qc);
+			while (t < text.size() && FuzzyFoldCase(text[t]) != qc)
+				t++;
+			if (t == text.size())
+				return -1;
+
+			score += score_match;
+			if (prev != std::string_view::npos && t == prev + 1)
+				score += bonus_consecutive;
+			else if (prev != std::string_view::npos)
+				score -= (int)std::min<size_t>(t - prev - 1, max_gap_penalty);
+			if (t == 0)
+				score += bonus_first_char;
+			else if (is_word_start(t))
+				score += bonus_word_start;
+			prev = t++;
+		}
+		return std::max(0, score - (int)std::min<size_t>(text.size() / 8, 64));
+	}
+
+	std::span<FuzzyIndex::Match const> FuzzyIndex::Search(std::string_view query)
+	{
+		if (mQueryValid && query == mQuery)
+			return mMatches;
+
+		const uint64_t query_mask = FuzzyCharMask(query);
+		if (query.empty())
+			mMatches.clear();
+		else if (mQueryValid && !mQuery.empty() && query.starts_with(mQuery))
+		{
+			// Items not matching a query don't match any query extending it: only retest the previous matches
+			std::erase_if(mMatches, [&](Match& match) {
+				if ((mMasks[match.Item] & query_mask) != query_mask)
+					return true;
+				match.Score = FuzzyScore(query, mItems[match.Item]);
+				return match.Score < 0;
+			});
+		}
+		else
+		{
+			mMatches.clear();
+			for (size_t i = 0; i < mItems.size(); i++)
+			{
+				if ((mMasks[i] & query_mask) != query_mask)
+					continue;
+				if (const int score = FuzzyScore(query, mItems[i]); score >= 0)
+					mMatches.push_back({ (uint32_t)i, score });
+			}
+		}
+
+		mQuery = query;
+		mQueryValid = true;
+		mBest.clear();
+		return mMatches;
+	}
+
+	std::span<FuzzyIndex::Match const> FuzzyIndex::SearchBest(std::string_view query, size_t max_results)
+	{
+		const bool same_query = mQueryValid && query == mQuery;
+		auto const matches = Search(query);
+		if (same_query && mBest.size() == std::min(max_results, matches.size()))
+			return mBest;
+
+		auto const better = [](Match const& a, Match const& b) { return a.Score != b.Score ? a.Score > b.Score : a.Item < b.Item; };
+		mBest.resize(std::min(max_results, matches.size()));
+		std::partial_sort_copy(matches.begin(), matches.end(), mBest.begin(), mBest.end(), better);
+		return mBest;
+	}
+
+	bool FuzzyIndex::GlobMatch(std::string_view pattern, std::string_view text)
+	{
+		// Iterative matching, backtracking to the last '*' on mismatch
+		size_t p = 0, t = 0, star = std::string_view::npos, star_text = 0;
+		while (t < text.size())
+		{
+			if (p < pattern.size() && (pattern[p] == '?' || (pattern[p] != '*' && FuzzyFoldCase(pattern[p]) == FuzzyFoldCase(text[t]))))
+			{
+				p++;
+				t++;
+			}
+			else if (p < pattern.size() && pattern[p] == '*')
+			{
+				star = p++;
+				star_text = t;
+			}
+			else if (star != std::string_view::npos)
+			{
+				p = star + 1;
+				t = ++star_text;
+			}
+			else
+				return false;
+		}
+		while (p < pattern.size() && pattern[p] == '*')
+			p++;
+		return p == pattern.size();
+	}
+
+	/// Calls func(pattern, mask of its literal characters) for each ';' separated pattern, until it returns true
+	template <typename FUNC>
+	static bool ForEachGlobPattern(std::string_view patterns, FUNC&& func)
+	{
+		while (!patterns.empty())
+		{
+			const size_t end = patterns.find(';');
+			std::string_view pattern = patterns.substr(0, end);
+			patterns = (end == std::string_view::npos) ? std::string_view{} : patterns.substr(end + 1);
+
+			while (!pattern.empty() && pattern.front() == ' ') pattern.remove_prefix(1);
+			while (!pattern.empty() && pattern.back() == ' ') pattern.remove_suffix(1);
+			if (pattern.empty())
+				continue;
+
+			uint64_t literal_mask = 0;
+			for (const char c : pattern)
+				if (c != '*' && c != '?')
+					literal_mask |= FuzzyCharMask({ &c, 1 });
+			if (func(pattern, literal_mask))
+				return true;
+		}
+		return false;
+	}
+
+	bool FuzzyIndex::MatchesGlob(size_t index, std::string_view patterns) const
+	{
+		return ForEachGlobPattern(patterns, [&](std::string_view pattern, uint64_t literal_mask) {
+			return (mMasks[index] & literal_mask) == literal_mask && GlobMatch(pattern, mItems[index]);
+		});
+	}
+
+	void FuzzyIndex::Glob(std::string_view patterns, std::vector<uint32_t>& out) const
+	{
+		std::vector<std::pair<std::string_view, uint64_t>> parsed;
+		ForEachGlobPattern(patterns, [&](std::string_view pattern, uint64_t literal_mask) { parsed.emplace_back(pattern, literal_mask); return false; });
+
+		out.clear();
+		for (size_t i = 0; i < mItems.size(); i++)
+		{
+			for (auto const& [pattern, literal_mask] : parsed)
+			{
+				if ((mMasks[i] & literal_mask) == literal_mask && GlobMatch(pattern, mItems[i]))
+				{
+					out.push_back((uint32_t)i);
+					break;
+				}
+			}
+		}
+	}
+
+	LogView::LogView(size_t max_lines, size_t max_bytes, size_t queue_capacity)
+		: mQueue(queue_capacity)
+		, mLines(std::max<size_t>(max_lines, 1))
+		, mText(std::clamp<size_t>(max_bytes, 1, UINT32_MAX))
+	{
+	}
+
+	bool LogView::Push(std::string_view text, LogSeverity severity, ImU32 color)
+	{
+		// Assigning into the cell's string reuses the storage of a previously drained line
+		const bool pushed = mQueue.TryPushWith([&](PendingLine& line) {
+			line.Text.assign(text);
+			line.Color = color;
+			line.Severity = severity;
+		});
+		if (!pushed)
+			mDropped.fetch_add(1, std::memory_order_relaxed);
+		return pushed;
+	}
+
+	bool LogView::Push(std::string&& text, LogSeverity severity, ImU32 color)
+	{
+		const bool pushed = mQueue.TryPushWith([&](PendingLine& line) {
+			line.Text = std::move(text);
+			line.Color = color;
+			line.Severity = severity;
+		});
+		if (!pushed)
+			mDropped.fetch_add(1, std::memory_order_relaxed);
+		return pushed;
+	}
+
+	void LogView::Drain()
+	{
+		// Bounded so that fast producers can't keep the UI thread here
+		for (size_t n = mQueue.Capacity(); n > 0 && mQueue.TryPop(mPopped); n--)
+		{
+			const char* begin = mPopped.Text.data();
+			const char* end = begin + mPopped.Text.size();
+			if (begin != end && end[-1] == '\n')
+				end--;
+			for (;;)
+			{
+				const char* eol = (const char*)std::memchr(begin, '\n', end - begin);
+				if (!eol)
+				{
+					AppendLine(begin, end - begin, mPopped.Severity, mPopped.Color);
+					break;
+				}
+				AppendLine(begin, eol - begin, mPopped.Severity, mPopped.Color);
+				begin = eol + 1;
+			}
+		}
+	}
+
+	void LogView::Clear()
+	{
+		mFirstLine = 0;
+		mLineCount = 0;
+		mFirstLineId = 0;
+		mTextWritePos = 0;
+		mFiltered.clear();
+	}
+
+	void LogView::AppendLine(const char* text, size_t length, LogSeverity severity, ImU32 color)
+	{
+		if (mLineCount == mLines.size())
+			PopOldestLine();
+
+		length = std::min(length, mText.size());
+		size_t offset = mTextWritePos;
+		if (offset + length > mText.size())
+		{
+			// Skip the end of the text ring; the lines still stored there are the oldest ones
+			while (mLineCount > 0 && mLines[mFirstLine].Offset >= mTextWritePos)
+				PopOldestLine();
+			offset = 0;
+		}
+		// Lines are stored in order, so only the oldest lines can occupy the bytes ahead of the write position
+		while (mLineCount > 0 && mLines[mFirstLine].Offset >= offset && mLines[mFirstLine].Offset < offset + length)
+			PopOldestLine();
+
+		std::memcpy(mText.data() + offset, text, length);
+		mTextWritePos = offset + length;
+
+		Line& line = mLines[(mFirstLine + mLineCount) % mLines.size()];
+		line = { (uint32_t)offset, (uint32_t)length, color, severity };
+		mLineCount++;
+		if (PassFilter(line))
+			mFiltered.push_back(mFirstLineId + mLineCount - 1);
+	}
+
+	void LogView::PopOldestLine()
+	{
+		if (!mFiltered.empty() && mFiltered.front() == mFirstLineId)
+			mFiltered.pop_front();
+		mFirstLine = (mFirstLine + 1) % mLines.size();
+		mLineCount--;
+		mFirstLineId++;
+	}
+
+	bool LogView::PassFilter(Line const& line) const
+	{
+		if (line.Severity < MinSeverity)
+			return false;
+		if (!Filter.IsActive())
+			return true;
+		const char* begin = mText.data() + line.Offset;
+		return Filter.PassFilter(ImStrv{ begin, begin + line.Length });
+	}
+
+	void LogView::RebuildFiltered()
+	{
+		mFilterText = Filter.InputBuf;
+		mFilterSeverity = MinSeverity;
+		mFiltered.clear();
+		for (uint64_t id = mFirstLineId; id < mFirstLineId + mLineCount; id++)
+			if (PassFilter(LineAt(id)))
+				mFiltered.push_back(id);
+	}
+
+	ImU32 LogView::SeverityColor(LogSeverity severity)
+	{
+		switch (severity)
+		{
+		case LogSeverity::Trace: return ImGui::GetColorU32(ImGuiCol_TextDisabled);
+		case LogSeverity::Debug: return ImGui::GetColorU32(ImGuiCol_Text, 0.75f);
+		case LogSeverity::Warning: return IM_COL32(255, 200, 0, 255);
+		case LogSeverity::Error: return IM_COL32(255, 90, 90, 255);
+		case LogSeverity::Critical: return IM_COL32(255, 60, 200, 255);
+		default: return ImGui::GetColorU32(ImGuiCol_Text);
+		}
+	}
+
+	void LogView::Draw(ImStrv id, ImVec2 const& size)
+	{
+		if (mFilterText != Filter.InputBuf || mFilterSeverity != MinSeverity)
+			RebuildFiltered();
+		Drain();
+
+		if (ImGui::BeginChild(id, size, ImGuiChildFlags_None, ImGuiWindowFlags_HorizontalScrollbar))
+		{
+			const ImU32 text_color = ImGui::GetColorU32(ImGuiCol_Text);
+			ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(0, 0));
+			ImGuiListClipper clipper;
+			clipper.Begin((int)mFiltered.size());
+			while (clipper.Step())
+			{
+				for (int n = clipper.DisplayStart; n < clipper.DisplayEnd; n++)
+				{
+					Line const& line = LineAt(mFiltered[n]);
+					const ImU32 color = line.Color ? line.Color : SeverityColor(line.Severity);
+					if (color != text_color)
+						ImGui::PushStyleColor(ImGuiCol_Text, color);
+					ImGui::TextUnformatted(LineText(line));
+					if (color != text_color)
+						ImGui::PopStyleColor();
+				}
+			}
+			clipper.End();
+			ImGui::PopStyleVar();
+
+			if (AutoScroll && ImGui::GetScrollY() >= ImGui::GetScrollMaxY())
+				ImGui::SetScrollHereY(1.0f);
+		}
+		ImGui::EndChild();
+	}
+
+	void LogView::DrawOptions()
+	{
+		if (ImGui::Button("Clear"))
+			Clear();
+		ImGui::SameLine();
+		ImGui::Checkbox("Auto-scroll", &AutoScroll);
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth(ImGui::GetFontSize() * 7.0f);
+		if (ImGui::BeginCombo("##MinSeverity", magic_enum::enum_name(MinSeverity)))
+		{
+			for (auto& [value, name] : magic_enum::enum_entries<LogSeverity>())
+				if (ImGui::Selectable(name, MinSeverity == value))
+					MinSeverity = value;
+			ImGui::EndCombo();
+		}
+		ImGui::SameLine();
+		Filter.Draw("##Filter", -FLT_MIN);
+	}
+
+	ToastManager::ToastManager(size_t pool_size, size_t queue_capacity)
+		: mQueue(queue_capacity)
+		, mSlots(std::max<size_t>(pool_size, 1))
+	{
+		mOrder.reserve(mSlots.size());
+		for (size_t i = 0; i < mSlots.size(); i++)
+			ImFormatString(mSlots[i].WindowName, sizeof(mSlots[i].WindowName), "##TOAST%u", (unsigned)i);
+	}
+
+	/// Longest prefix of `text` no longer than `max` that doesn't cut a UTF-8 sequence
+	static size_t ToastTextLength(std::string_view text, size_t max) noexcept
+	{
+		if (text.size() <= max)
+			return text.size();
+		size_t length = max;
+		while (length > 0 && (text[length] & 0xC0) == 0x80)
+			length--;
+		return length;
+	}
+
+	bool ToastManager::Push(ToastType type, std::string_view title, std::string_view content, std::chrono::milliseconds display_time)
+	{
+		const bool pushed = mQueue.TryPushWith([&](Request& request) {
+			request.Type = type;
+			request.DisplayMs = (uint32_t)std::clamp<int64_t>(display_time.count(), 0, UINT32_MAX);
+			request.TitleLength = (uint8_t)ToastTextLength(title, MaxTitleLength);
+			request.ContentLength = (uint16_t)ToastTextLength(content, MaxContentLength);
+			std::memcpy(request.Title, title.data(), request.TitleLength);
+			std::memcpy(request.Content, content.data(), request.ContentLength);
+			request.Title[request.TitleLength] = 0;
+			request.Content[request.ContentLength] = 0;
+			// Hashed here so the UI thread only has to compare texts on a hash match
+			request.Hash = ImHashData(&request.Type, sizeof(request.Type), ImHashStr(request.TitleText(), ImHashStr(request.ContentText())));
+		});
+		if (!pushed)
+			mDropped.fetch_add(1, std::memory_order_relaxed);
+		return pushed;
+	}
+
+	ToastManager::Slot& ToastManager::Show(Request const& request, clock::time_point now)
+	{
+		// Reuse a free slot, or replace the oldest toast
+		uint32_t index;
+		if (mOrder.size() < mSlots.size())
+		{
+			index = 0;
+			while (mSlots[index].Count != 0)
+				index++;
+		}
+		else
+		{
+			index = mOrder.front();
+			mOrder.erase(mOrder.begin());
+		}
+		mOrder.push_back(index);
+
+		auto& slot = mSlots[index];
+		slot.Toast = request;
+		slot.Count = 1;
+		slot.Start = now;
+		slot.End = now + FadeTime + (request.DisplayMs ? std::chrono::milliseconds{ request.DisplayMs } : DisplayTime);
+		return slot;
+	}
+
+	void ToastManager::UpdateSummary(clock::time_point now)
+	{
+		if (mSuppressed == mSuppressedSummarized)
+			return;
+
+		// Hash 0 marks the summary; a pushed toast hashing to 0 just won't be coalesced with it
+		Slot* summary = nullptr;
+		for (auto index : mOrder)
+		{
+			if (mSlots[index].Toast.Hash == 0)
+				summary = &mSlots[index];
+		}
+
+		if (summary)
+		{
+			summary->Count += uint32_t(mSuppressed - mSuppressedSummarized);
+			summary->Start = std::min(summary->Start, now - FadeTime);
+			summary->End = now + DisplayTime;
+		}
+		else
+		{
+			Request request{};
+			request.Type = ToastType::Warning;
+			summary = &Show(request, now);
+			summary->Count = uint32_t(mSuppressed - mSuppressedSummarized);
+		}
+		mSuppressedSummarized = mSuppressed;
+
+		auto& toast = summary->Toast;
+		const auto written = std::format_to_n(toast.Content, MaxContentLength, "{} more notifications were not shown", summary->Count);
+		toast.ContentLength = (uint16_t)written.size;
+		toast.Content[toast.ContentLength] = 0;
+	}
+
+	void ToastManager::Render()
+	{
+		using namespace ImGui;
+
+		const auto now = clock::now();
+
+		// Refill the rate limit tokens
+		if (mLastRefill == clock::time_point{})
+			mTokens = MaxBurst;
+		else
+			mTokens = std::min(MaxBurst, mTokens + std::chrono::duration<float>(now - mLastRefill).count() * MaxPerSecond);
+		mLastRefill = now;
+
+		// Bounded so that fast producers can't keep the UI thread here
+		for (size_t n = mQueue.Capacity(); n > 0 && mQueue.TryPop(mPopped); n--)
+		{
+			Slot* same = nullptr;
+			for (auto index : mOrder)
+			{
+				auto& slot = mSlots[index];
+				if (slot.Toast.Hash == mPopped.Hash && slot.Toast.SameText(mPopped))
+					same = &slot;
+			}
+
+			if (same)
+			{
+				// Stay (or become again) opaque, and restart the display time
+				same->Count++;
+				same->Start = std::min(same->Start, now - FadeTime);
+				same->End = now + (mPopped.DisplayMs ? std::chrono::milliseconds{ mPopped.DisplayMs } : DisplayTime);
+				mCoalesced++;
+			}
+			else if (mTokens >= 1.0f)
+			{
+				mTokens -= 1.0f;
+				Show(mPopped, now);
+			}
+			else
+				mSuppressed++;
+		}
+
+		UpdateSummary(now);
+
+		// Retire expired toasts, oldest first
+		std::erase_if(mOrder, [&](uint32_t index) {
+			auto& slot = mSlots[index];
+			if (now < slot.End + FadeTime)
+				return false;
+			slot.Count = 0;
+			return true;
+		});
+
+		const auto viewport = GetMainViewport();
+		const auto fade_time = std::chrono::duration<float>(FadeTime).count();
+
+		// Newest at the bottom, stacked upwards in one pass
+		float height = 0.0f;
+		for (auto it = mOrder.rbegin(); it != mOrder.rend(); ++it)
+		{
+			auto& slot = mSlots[*it];
+			auto const& toast = slot.Toast;
+
+			float opacity = 1.0f;
+			if (fade_time > 0.0f)
+			{
+				const auto fade_in = std::chrono::duration<float>(now - slot.Start).count() / fade_time;
+				const auto fade_out = std::chrono::duration<float>(slot.End + FadeTime - now).count() / fade_time;
+				opacity = ImSaturate(std::min(fade_in, fade_out));
+			}
+
+			auto text_color = Color(toast.Type);
+			text_color.w = opacity;
+
+			SetNextWindowBgAlpha(opacity);
+			SetNextWindowPos(viewport->Pos + ImVec2(viewport->Size.x - Padding.x, viewport->Size.y - Padding.y - height), ImGuiCond_Always, ImVec2(1.0f, 1.0f));
+			Begin(slot.WindowName, nullptr, WindowFlags);
+			BringWindowToDisplayFront(GetCurrentWindow());
+
+			PushTextWrapPos(viewport->Size.x * WrapWidthFraction);
+
+			const auto icon = DefaultIcon(toast.Type);
+			const auto title = toast.TitleLength ? toast.TitleText() : DefaultTitle(toast.Type);
+			const bool has_content = toast.ContentLength > 0;
+			bool was_title_rendered = false;
+
+			if (!icon.empty())
+			{
+				PushStyleColor(ImGuiCol_Text, text_color);
+				TextUnformatted(icon);
+				PopStyleColor();
+				was_title_rendered = true;
+			}
+
+			if (!title.empty())
+			{
+				if (was_title_rendered)
+					SameLine();
+				TextUnformatted(title);
+				was_title_rendered = true;
+			}
+
+			// The summary shows its count in its content
+			if (slot.Count > 1 && toast.Hash != 0)
+			{
+				if (was_title_rendered)
+					SameLine();
+				TextDisabled("(x%u)", slot.Count);
+				was_title_rendered = true;
+			}
+
+			if (has_content)
+			{
+				if (was_title_rendered && Separator)
+					ImGui::Separator();
+				TextUnformatted(toast.ContentText());
+			}
+
+			PopTextWrapPos();
+
+			if (IsWindowHovered() && IsMouseClicked(ImGuiMouseButton_Left))
+				slot.End = std::min(slot.End, now);
+
+			height += GetWindowHeight() + Spacing;
+			End();
+		}
+	}
+
+	void ToastManager::DismissAll()
+	{
+		const auto now = clock::now();
+		for (auto index : mOrder)
+			mSlots[index].End = std::min(mSlots[index].End, now);
+	}
+
+	ImVec4 ToastManager::Color(ToastType type) noexcept
+	{
+		switch (type)
+		{
+		case ToastType::Success: return { 0, 1, 0, 1 }; // Green
+		case ToastType::Info: return { 0, 157.0f / 255.0f, 1, 1 }; // Blue
+		case ToastType::Warning: return { 1, 1, 0, 1 }; // Yellow
+		case ToastType::Error: return { 1, 0, 0, 1 }; // Red
+		default: return { 1, 1, 1, 1 }; // White
+		}
+	}
+
+	std::string_view ToastManager::DefaultTitle(ToastType type) noexcept
+	{
+		switch (type)
+		{
+		case ToastType::Success: return "Success";
+		case ToastType::Info: return "Info";
+		case ToastType::Warning: return "Warning";
+		case ToastType::Error: return "Error";
+		default: return {};
+		}
+	}
+
+	std::string_view ToastManager::DefaultIcon(ToastType type) noexcept
+	{
+		switch (type)
+		{
+		case ToastType::Success: return "\xef\x81\x98";
+		case ToastType::Info: return "\xef\x81\x9a";
+		case ToastType::Warning: return "\xef\x81\xb1";
+		case ToastType::Error: return "\xef\x81\x97";
+		default: return {};
+		}
+	}
+
+	ToastManager& Toasts(ImGuiContext* ctx)
+	{
+		static const ImGuiID owner = ImHashStr("ig::Toasts");
+		return ContextState<ToastManager>(owner, ctx);
+	}
+
+	ValueRange ValueRangeOf(std::span<float const> values) noexcept
+	{
+		// Independent lanes let the compiler keep each in a SIMD register; `v < lo ? v : lo` is what minps does, which also skips NaNs
+		constexpr size_t lanes = 8;
+		float lo[lanes], hi[lanes];
+		std::fill_n(lo, lanes, FLT_MAX);
+		std::fill_n(hi, lanes, -FLT_MAX);
+
+		const float* v = values.data();
+		const size_t bulk = values.size() / lanes * lanes;
+		for (size_t i = 0; i < bulk; i += lanes)
+		{
+			for (size_t l = 0; l < lanes; l++)
+			{
+				lo[l] = v[i + l] < lo[l] ? v[i + l] : lo[l];
+				hi[l] = v[i + l] > hi[l] ? v[i + l] : hi[l];
+			}
+		}
+
+		ValueRange result;
+		for (size_t l = 0; l < lanes; l++)
+			result.Add(ValueRange{ lo[l], hi[l] });
+		for (size_t i = bulk; i < values.size(); i++)
+			result.Add(v[i]);
+		return result;
+	}
+
+	void PlotSummary::Build(std::span<float const> values)
+	{
+		Clear();
+		mSize = values.size();
+
+		size_t count = (mSize + BlockSize - 1) / BlockSize;
+		mBlocks.reserve(count * 2);
+		mLevelOffsets.push_back(0);
+		for (size_t i = 0; i < count; i++)
+			mBlocks.push_back(ValueRangeOf(values.subspan(i * BlockSize, std::min(BlockSize, mSize - i * BlockSize))));
+
+		while (count > 1)
+		{
+			const size_t previous = mLevelOffsets.back();
+			mLevelOffsets.push_back(mBlocks.size());
+			for (size_t i = 0; i < count; i += 2)
+			{
+				auto range = mBlocks[previous + i];
+				if (i + 1 < count)
+					range.Add(mBlocks[previous + i + 1]);
+				mBlocks.push_back(range);
+			}
+			count = (count + 1) / 2;
+		}
+	}
+
+	void PlotSummary::Clear()
+	{
+		mSize = 0;
+		mBlocks.clear();
+		mLevelOffsets.clear();
+	}
+
+	ValueRange PlotSummary::MinMax(std::span<float const> values, size_t begin, size_t end) const
+	{
+		IM_ASSERT(values.size() == mSize && begin <= end && end <= mSize);
+
+		// Values in the partial blocks at both ends are scanned directly
+		size_t first = (begin + BlockSize - 1) / BlockSize;
+		size_t last = end / BlockSize;
+		if (first >= last)
+			return ValueRangeOf(values.subspan(begin, end - begin));
+
+		ValueRange result = ValueRangeOf(values.subspan(begin, first * BlockSize - begin));
+		result.Add(ValueRangeOf(values.subspan(last * BlockSize, end - last * BlockSize)));
+
+		// The whole blocks, going up the pyramid like a bottom-up segment tree
+		for (size_t level = 0; first < last; level++)
+		{
+			const auto blocks = mBlocks.data() + mLevelOffsets[level];
+			if (first & 1)
+				result.Add(blocks[first++]);
+			if (last & 1)
+				result.Add(blocks[--last]);
+			first /= 2;
+			last /= 2;
+		}
+		return result;
+	}
+
+	/// `range_of(begin, end)` returns the ValueRange of the values [begin, end)
+	template <typename RANGE_OF>
+	static int PlotDecimated(ImGuiPlotType plot_type, ImStrv label, size_t values_count, RANGE_OF&& range_of, ImStrv overlay_text, float scale_min, float scale_max, ImVec2 const& size_arg)
+	{
+		using namespace ImGui;
+
+		ImGuiContext& g = *GImGui;
+		ImGuiWindow* window = GetCurrentWindow();
+		if (window->SkipItems)
+			return -1;
+
+		const ImGuiStyle& style = g.Style;
+		const ImGuiID id = window->GetID(label);
+
+		const ImVec2 label_size = CalcTextSize(label, true);
+		const ImVec2 frame_size = CalcItemSize(size_arg, CalcItemWidth(), label_size.y + style.FramePadding.y * 2.0f);
+
+		const ImRect frame_bb(window->DC.CursorPos, window->DC.CursorPos + frame_size);
+		const ImRect inner_bb(frame_bb.Min + style.FramePadding, frame_bb.Max - style.FramePadding);
+		const ImRect total_bb(frame_bb.Min, frame_bb.Max + ImVec2(label_size.x > 0.0f ? style.ItemInnerSpacing.x + label_size.x : 0.0f, 0));
+		ItemSize(total_bb, style.FramePadding.y);
+		if (!ItemAdd(total_bb, 0, &frame_bb))
+			return -1;
+		const bool hovered = ItemHoverable(frame_bb, id, g.LastItemData.InFlags);
+
+		if (scale_min == FLT_MAX || scale_max == FLT_MAX)
+		{
+			const auto range = range_of(0, values_count);
+			if (scale_min == FLT_MAX)
+				scale_min = range.Min;
+			if (scale_max == FLT_MAX)
+				scale_max = range.Max;
+		}
+
+		RenderFrame(frame_bb.Min, frame_bb.Max, GetColorU32(ImGuiCol_FrameBg), true, style.FrameRounding);
+
+		const bool lines = plot_type == ImGuiPlotType_Lines;
+		int idx_hovered = -1;
+		if (values_count >= (lines ? 2u : 1u))
+		{
+			// At most one column per pixel, column `c` covering the values [column_begin(c), column_begin(c + 1))
+			const size_t columns = std::min(std::max<size_t>((size_t)inner_bb.GetWidth(), 1), values_count);
+			const auto column_begin = [&](size_t c) { return (size_t)((uint64_t)c * values_count / columns); };
+			// Lines put the columns on both edges, histogram bars fill the width
+			const float t_step = lines ? 1.0f / (float)std::max<size_t>(columns - 1, 1) : 1.0f / (float)columns;
+
+			size_t column_hovered = SIZE_MAX;
+			if (hovered && inner_bb.Contains(g.IO.MousePos))
+			{
+				const float t = ImClamp((g.IO.MousePos.x - inner_bb.Min.x) / (inner_bb.Max.x - inner_bb.Min.x), 0.0f, 0.9999f);
+				column_hovered = lines ? (size_t)(t * (float)(columns - 1) + 0.5f) : (size_t)(t * (float)columns);
+				const size_t begin = column_begin(column_hovered);
+				const size_t end = column_begin(column_hovered + 1);
+				const auto range = range_of(begin, end);
+				if (end - begin == 1)
+					SetTooltip("%d: %8.4g", (int)begin, range.Min);
+				else
+					SetTooltip("%d..%d: %8.4g .. %8.4g", (int)begin, (int)end - 1, range.Min, range.Max);
+				idx_hovered = (int)begin;
+			}
+
+			const float inv_scale = (scale_min == scale_max) ? 0.0f : (1.0f / (scale_max - scale_min));
+			const auto y_of = [&](float v) { return ImLerp(inner_bb.Min.y, inner_bb.Max.y, 1.0f - ImSaturate((v - scale_min) * inv_scale)); };
+			const auto x_of = [&](size_t c) { return ImLerp(inner_bb.Min.x, inner_bb.Max.x, (float)c * t_step); };
+
+			const ImU32 col_base = GetColorU32(lines ? ImGuiCol_PlotLines : ImGuiCol_PlotHistogram);
+			const ImU32 col_hovered = GetColorU32(lines ? ImGuiCol_PlotLinesHovered : ImGuiCol_PlotHistogramHovered);
+
+			if (lines)
+			{
+				// One polyline through the top and bottom of each column, going first to the end nearest to the previous point.
+				// Columns with only NaNs break the line.
+				// At most two points per column, in scratch memory which doesn't outlive the frame.
+				ImVec2* points = (ImVec2*)MemAllocTransient(columns * 2 * sizeof(ImVec2));
+				int points_count = 0;
+				const auto flush = [&] {
+					if (points_count >= 2)
+						window->DrawList->AddPolyline(points, points_count, col_base, ImDrawFlags_None, 1.0f);
+					points_count = 0;
+				};
+
+				for (size_t c = 0; c < columns; c++)
+				{
+					const auto range = range_of(column_begin(c), column_begin(c + 1));
+					if (range.Empty())
+					{
+						flush();
+						continue;
+					}
+
+					const float x = x_of(c);
+					const float y_top = y_of(range.Max);
+					const float y_bottom = y_of(range.Min);
+					if (y_top == y_bottom)
+						points[points_count++] = ImVec2(x, y_top);
+					else if (points_count > 0 && ImAbs(points[points_count - 1].y - y_top) < ImAbs(points[points_count - 1].y - y_bottom))
+					{
+						points[points_count++] = ImVec2(x, y_top);
+						points[points_count++] = ImVec2(x, y_bottom);
+					}
+					else
+					{
+						points[points_count++] = ImVec2(x, y_bottom);
+						points[points_count++] = ImVec2(x, y_top);
+					}
+
+					if (c == column_hovered)
+						window->DrawList->AddRectFilled(ImVec2(x - 1.0f, y_top - 1.0f), ImVec2(x + 1.0f, y_bottom + 1.0f), col_hovered);
+				}
+				flush();
+				MemFreeTransient(points);
+			}
+			else
+			{
+				// Bars go from the zero line to the farthest values of their column on either side of it
+				const float histogram_zero_line_t = (scale_min * scale_max < 0.0f) ? (1 + scale_min * inv_scale) : (scale_min < 0.0f ? 0.0f : 1.0f);
+				const float y_zero = ImLerp(inner_bb.Min.y, inner_bb.Max.y, histogram_zero_line_t);
+				for (size_t c = 0; c < columns; c++)
+				{
+					const auto range = range_of(column_begin(c), column_begin(c + 1));
+					if (range.Empty())
+						continue;
+
+					const float x0 = x_of(c);
+					float x1 = x_of(c + 1);
+					if (x1 >= x0 + 2.0f)
+						x1 -= 1.0f;
+					window->DrawList->AddRectFilled(ImVec2(x0, ImMin(y_of(range.Max), y_zero)), ImVec2(x1, ImMax(y_of(range.Min), y_zero)), c == column_hovered ? col_hovered : col_base);
+				}
+			}
+		}
+
+		if (overlay_text)
+			RenderTextClipped(ImVec2(frame_bb.Min.x, frame_bb.Min.y + style.FramePadding.y), frame_bb.Max, overlay_text, NULL, ImVec2(0.5f, 0.0f));
+
+		if (label_size.x > 0.0f)
+			RenderText(ImVec2(frame_bb.Max.x + style.ItemInnerSpacing.x, inner_bb.Min.y), label);
+
+		return idx_hovered;
+	}
+
+	static int PlotDecimated(ImGuiPlotType plot_type, ImStrv label, std::span<float const> values, PlotSummary const* summary, ImStrv overlay_text, float scale_min, float scale_max, ImVec2 const& size_arg)
+	{
+		IM_ASSERT(!summary || summary->Size() == values.size());
+		const auto range_of = [&](size_t begin, size_t end) {
+			return summary ? summary->MinMax(values, begin, end) : ValueRangeOf(values.subspan(begin, end - begin));
+		};
+		return PlotDecimated(plot_type, label, values.size(), range_of, overlay_text, scale_min, scale_max, size_arg);
+	}
+
+	int PlotLines(ImStrv label, std::span<float const> values, PlotSummary const* summary, ImStrv overlay_text, float scale_min, float scale_max, ImVec2 graph_size)
+	{
+		return PlotDecimated(ImGuiPlotType_Lines, label, values, summary, overlay_text, scale_min, scale_max, graph_size);
+	}
+
+	int PlotHistogram(ImStrv label, std::span<float const> values, PlotSummary const* summary, ImStrv overlay_text, float scale_min, float scale_max, ImVec2 graph_size)
+	{
+		return PlotDecimated(ImGuiPlotType_Histogram, label, values, summary, overlay_text, scale_min, scale_max, graph_size);
+	}
+
+	StreamingPlot::StreamingPlot(size_t history, size_t queue_capacity)
+		: mQueue(queue_capacity)
+		, mValues(std::max<size_t>(history, 1))
+		, mLeaves(std::bit_ceil(mValues.size()))
+		, mTree(mLeaves * 2)
+	{
+	}
+
+	bool StreamingPlot::Push(float value)
+	{
+		const bool pushed = mQueue.TryPush(value);
+		if (!pushed)
+			mDropped.fetch_add(1, std::memory_order_relaxed);
+		return pushed;
+	}
+
+	void StreamingPlot::Clear()
+	{
+		mHead = 0;
+		mSize = 0;
+		std::fill(mTree.begin(), mTree.end(), ValueRange{});
+	}
+
+	void StreamingPlot::Drain()
+	{
+		float value = 0.0f;
+		// Bounded so that fast producers can't keep the UI thread here
+		for (size_t n = mQueue.Capacity(); n > 0 && mQueue.TryPop(value); n--)
+		{
+			if (mSize < mValues.size())
+				Set((mHead + mSize++) % mValues.size(), value);
+			else
+			{
+				Set(mHead, value);
+				mHead = (mHead + 1) % mValues.size();
+			}
+		}
+	}
+
+	void StreamingPlot::Set(size_t slot, float value) noexcept
+	{
+		mValues[slot] = value;
+		size_t node = mLeaves + slot;
+		mTree[node] = {};
+		mTree[node].Add(value);
+		for (node /= 2; node > 0; node /= 2)
+		{
+			mTree[node] = mTree[node * 2];
+			mTree[node].Add(mTree[node * 2 + 1]);
+		}
+	}
+
+	ValueRange StreamingPlot::SlotRange(size_t begin, size_t end) const noexcept
+	{
+		ValueRange result;
+		for (begin += mLeaves, end += mLeaves; begin < end; begin /= 2, end /= 2)
+		{
+			if (begin & 1)
+				result.Add(mTree[begin++]);
+			if (end & 1)
+				result.Add(mTree[--end]);
+		}
+		return result;
+	}
+
+	ValueRange StreamingPlot::Range(size_t begin, size_t end) const noexcept
+	{
+		IM_ASSERT(begin <= end && end <= mSize);
+		// The values wrap around the end of the ring at most once
+		const size_t capacity = mValues.size();
+		begin = mHead + begin;
+		end = mHead + end;
+		if (end <= capacity)
+			return SlotRange(begin, end);
+		if (begin >= capacity)
+			return SlotRange(begin - capacity, end - capacity);
+		auto result = SlotRange(begin, capacity);
+		result.Add(SlotRange(0, end - capacity));
+		return result;
+	}
+
+	int StreamingPlot::Draw(ImStrv label, ImStrv overlay_text, float scale_min, float scale_max, ImVec2 graph_size)
+	{
+		Drain();
+		const auto range_of = [this](size_t begin, size_t end) {
+			return begin == 0 && end == mSize ? Range() : Range(begin, end);
+		};
+		return PlotDecimated(PlotType, label, mSize, range_of, overlay_text, scale_min, scale_max, graph_size);
+	}
+
+	ImageSurface::ImageSurface(int width, int height, ImU32 color)
+		: mPixels(size_t(std::max(width, 1)) * std::max(height, 1), color)
+		, mWidth(std::max(width, 1))
+		, mHeight(std::max(height, 1))
+		, mTilesX((mWidth + TileSize - 1) / TileSize)
+		, mTilesY((mHeight + TileSize - 1) / TileSize)
+		, mDirtyTiles((size_t(mTilesX) * mTilesY + 63) / 64)
+	{
+		MarkDirty(0, 0, mWidth, mHeight);
+	}
+
+	/// The surfaces with a texture in a context, whose textures are destroyed with the context
+	struct ImageSurfaceRegistry
+	{
+		std::vector<ImageSurface*> Surfaces;
+
+		~ImageSurfaceRegistry()
+		{
+			for (ImageSurface* surface : Surfaces)
+				surface->DestroyTexture();
+		}
+	};
+
+	static ImageSurfaceRegistry& GetImageSurfaceRegistry(ImGuiContext* ctx)
+	{
+		static const ImGuiID owner = ImHashStr("ig::ImageSurface");
+		return ContextState<ImageSurfaceRegistry>(owner, ctx);
+	}
+
+	ImageSurface::~ImageSurface()
+	{
+		if (!mTexture)
+			return;
+		std::erase(GetImageSurfaceRegistry(mContext).Surfaces, this);
+		DestroyTexture();
+	}
+
+	void ImageSurface::DestroyTexture()
+	{
+		// The backend may already be shut down, having destroyed its textures
+		if (mContext->IO.RendererDestroyTextureFn)
+			mContext->IO.RendererDestroyTextureFn(mContext, mTexture);
+		mTexture = {};
+		mContext = nullptr;
+	}
+
+	void ImageSurface::SetPixel(int x, int y, ImU32 color) noexcept
+	{
+		IM_ASSERT(x >= 0 && x < mWidth && y >= 0 && y < mHeight);
+		mPixels[size_t(y) * mWidth + x] = color;
+		const size_t tile = size_t(y / TileSize) * mTilesX + x / TileSize;
+		const uint64_t bit = uint64_t(1) << (tile % 64);
+		if (!(mDirtyTiles[tile / 64] & bit))
+		{
+			mDirtyTiles[tile / 64] |= bit;
+			mDirtyCount++;
+			mDirtyRectsValid = false;
+		}
+	}
+
+	void ImageSurface::Fill(int x, int y, int w, int h, ImU32 color)
+	{
+		const int x0 = std::max(x, 0), y0 = std::max(y, 0);
+		const int x1 = std::min(x + w, mWidth), y1 = std::min(y + h, mHeight);
+		if (x0 >= x1 || y0 >= y1)
+			return;
+		for (int row = y0; row < y1; row++)
+			std::fill_n(mPixels.data() + size_t(row) * mWidth + x0, x1 - x0, color);
+		MarkDirty(x0, y0, x1 - x0, y1 - y0);
+	}
+
+	void ImageSurface::Heatmap(int x, int y, int w, int h, std::span<float const> values, float scale_min, float scale_max, std::span<ImU32 const> colormap)
+	{
+		IM_ASSERT(w >= 0 && h >= 0 && values.size() >= size_t(w) * h);
+		if (colormap.empty())
+			colormap = HeatmapColormap();
+		const int x0 = std::max(x, 0), y0 = std::max(y, 0);
+		const int x1 = std::min(x + w, mWidth), y1 = std::min(y + h, mHeight);
+		if (x0 >= x1 || y0 >= y1)
+			return;
+
+		// One multiply-add and a table lookup per value; NaNs come out transparent
+		const float last = float(colormap.size() - 1);
+		const float scale = scale_max != scale_min ? last / (scale_max - scale_min) : 0.0f;
+		const float offset = 0.5f - scale_min * scale;
+		for (int row = y0; row < y1; row++)
+		{
+			const float* src = values.data() + size_t(row - y) * w + (x0 - x);
+			ImU32* dst = mPixels.data() + size_t(row) * mWidth + x0;
+			for (int col = 0; col < x1 - x0; col++)
+			{
+				const float v = src[col];
+				dst[col] = v == v ? colormap[size_t(ImClamp(v * scale + offset, 0.0f, last))] : IM_COL32_BLACK_TRANS;
+			}
+		}
+		MarkDirty(x0, y0, x1 - x0, y1 - y0);
+	}
+
+	void ImageSurface::MarkDirty(int x, int y, int w, int h)
+	{
+		const int x0 = std::max(x, 0), y0 = std::max(y, 0);
+		const int x1 = std::min(x + w, mWidth), y1 = std::min(y + h, mHeight);
+		if (x0 >= x1 || y0 >= y1)
+			return;
+		for (int ty = y0 / TileSize; ty <= (y1 - 1) / TileSize; ty++)
+		{
+			for (int tx = x0 / TileSize; tx <= (x1 - 1) / TileSize; tx++)
+			{
+				const size_t tile = size_t(ty) * mTilesX + tx;
+				const uint64_t bit = uint64_t(1) << (tile % 64);
+				if (!(mDirtyTiles[tile / 64] & bit))
+				{
+					mDirtyTiles[tile / 64] |= bit;
+					mDirtyCount++;
+					mDirtyRectsValid = false;
+				}
+			}
+		}
+	}
+
+	std::span<ImTextureRect const> ImageSurface::DirtyRects()
+	{
+		if (mDirtyRectsValid)
+			return mDirtyRects;
+		mDirtyRects.clear();
+		mDirtyRectsValid = true;
+		if (mDirtyCount == 0)
+			return mDirtyRects;
+
+		// Runs of dirty tiles in a tile row become one rect, which grows down instead when the row above had the same run
+		thread_local std::vector<size_t> s_Above, s_Current;
+		s_Above.clear();
+		for (int ty = 0; ty < mTilesY; ty++)
+		{
+			s_Current.clear();
+			size_t above = 0;
+			const int y = ty * TileSize;
+			const int h = std::min(TileSize, mHeight - y);
+			for (int tx = 0; tx < mTilesX;)
+			{
+				const size_t row_tile = size_t(ty) * mTilesX;
+				const auto dirty = [&](int tx) { const size_t tile = row_tile + tx; return (mDirtyTiles[tile / 64] >> (tile % 64)) & 1; };
+				if (!dirty(tx))
+				{
+					tx++;
+					continue;
+				}
+				const int run_begin = tx;
+				while (tx < mTilesX && dirty(tx))
+					tx++;
+				const int x = run_begin * TileSize;
+				const int w = std::min(tx * TileSize, mWidth) - x;
+
+				while (above < s_Above.size() && mDirtyRects[s_Above[above]].x < x)
+					above++;
+				if (above < s_Above.size() && mDirtyRects[s_Above[above]].x == x && mDirtyRects[s_Above[above]].w == w)
+				{
+					mDirtyRects[s_Above[above]].h += h;
+					s_Current.push_back(s_Above[above++]);
+				}
+				else
+				{
+					s_Current.push_back(mDirtyRects.size());
+					mDirtyRects.push_back({ x, y, w, h });
+				}
+			}
+			std::swap(s_Above, s_Current);
+		}
+		return mDirtyRects;
+	}
+
+	bool ImageSurface::Upload()
+	{
+		if (!mTexture)
+		{
+			ImGuiIO& io = ImGui::GetIO();
+			if (!(io.BackendFlags & ImGuiBackendFlags_RendererHasTextureUpdates) || !io.RendererCreateTextureFn || !io.RendererUpdateTextureFn)
+				return false;
+			ImGuiContext* ctx = ImGui::GetCurrentContext();
+			mTexture = io.RendererCreateTextureFn(ctx, mWidth, mHeight);
+			if (!mTexture)
+				return false;
+			mContext = ctx;
+			GetImageSurfaceRegistry(mContext).Surfaces.push_back(this);
+			MarkDirty(0, 0, mWidth, mHeight);
+		}
+		IM_ASSERT(mContext == ImGui::GetCurrentContext() && "The texture belongs to another context!");
+
+		if (mDirtyCount == 0)
+			return true;
+		const auto rects = DirtyRects();
+		mContext->IO.RendererUpdateTextureFn(mContext, mTexture, rects.data(), int(rects.size()), mPixels.data(), Pitch());
+		std::fill(mDirtyTiles.begin(), mDirtyTiles.end(), 0);
+		mDirtyCount = 0;
+		mDirtyRects.clear();
+		return true;
+	}
+
+	void ImageSurface::Image(ImVec2 size, ImVec4 const& tint_col, ImVec4 const& border_col)
+	{
+		if (size.x <= 0.0f) size.x = float(mWidth);
+		if (size.y <= 0.0f) size.y = float(mHeight);
+		if (Upload())
+			ImGui::Image(mTexture, size, { 0, 0 }, { 1, 1 }, tint_col, border_col);
+		else
+			ImGui::Dummy(size);
+	}
+
+	std::span<ImU32 const> ImageSurface::HeatmapColormap() noexcept
+	{
+		static const auto colormap = [] {
+			static constexpr ImU8 stops[][3] = {
+				{ 68, 1, 84 }, { 71, 44, 122 }, { 59, 81, 139 }, { 44, 113, 142 }, { 33, 144, 141 },
+				{ 39, 173, 129 }, { 92, 200, 99 }, { 170, 220, 50 }, { 253, 231, 37 },
+			};
+			constexpr int segments = IM_ARRAYSIZE(stops) - 1;
+			std::array<ImU32, 256> result{};
+			for (int i = 0; i < 256; i++)
+			{
+				const float t = float(i) / 255.0f * segments;
+				const int s = std::min(int(t), segments - 1);
+				const float f = t - float(s);
+				const auto channel = [&](int c) { return ImU32(ImLerp(float(stops[s][c]), float(stops[s + 1][c]), f) + 0.5f); };
+				result[i] = IM_COL32(channel(0), channel(1), channel(2), 255);
+			}
+			return result;
+		}();
+		return colormap;
+	}
+
+	VirtualTree::VirtualTree(size_t node_count)
+	{
+		SetNodeCount(node_count);
+	}
+
+	void VirtualTree::SetNodeCount(size_t node_count)
+	{
+		mNodeCount = node_count;
+		mOpen.resize((node_count + 63) / 64);
+		// Drop the open bits past the end, so nodes added later start closed
+		if (node_count % 64)
+			mOpen.back() &= (uint64_t(1) << (node_count % 64)) - 1;
+		mExpand.reset();
+		mRowsValid = false;
+	}
+
+	void VirtualTree::Invalidate()
+	{
+		mRowsValid = false;
+		// The rows walked so far may not match the new children
+		if (mExpand)
+		{
+			const size_t node = mExpand->Node;
+			mExpand.reset();
+			ExpandAll(node);
+		}
+	}
+
+	void VirtualTree::SetOpenBit(size_t node, bool open) noexcept
+	{
+		IM_ASSERT(node < mNodeCount);
+		const uint64_t bit = uint64_t(1) << (node % 64);
+		if (open)
+			mOpen[node / 64] |= bit;
+		else
+			mOpen[node / 64] &= ~bit;
+	}
+
+	void VirtualTree::AppendRows(std::vector<Row>& rows, size_t node, size_t depth) const
+	{
+		// Pre-order walk through the open nodes only
+		thread_local std::vector<ExpandJob::Frame> s_Stack;
+		s_Stack.clear();
+		if (const size_t count = ChildCount(node))
+			s_Stack.push_back({ node, 0, count });
+		while (!s_Stack.empty())
+		{
+			auto& top = s_Stack.back();
+			if (top.Index == top.Count)
+			{
+				s_Stack.pop_back();
+				continue;
+			}
+			const size_t child = ChildAt(top.Node, top.Index++);
+			rows.push_back({ child, depth + s_Stack.size() - 1 });
+			if (IsOpen(child))
+				if (const size_t count = ChildCount(child))
+					s_Stack.push_back({ child, 0, count });
+		}
+	}
+
+	void VirtualTree::RebuildRows()
+	{
+		mRows.clear();
+		AppendRows(mRows, Root, 0);
+		mRowsValid = true;
+	}
+
+	size_t VirtualTree::FindRow(size_t node) const noexcept
+	{
+		const auto it = std::ranges::find(mRows, node, &Row::Node);
+		return it == mRows.end() ? SIZE_MAX : size_t(it - mRows.begin());
+	}
+
+	size_t VirtualTree::SubtreeEnd(size_t row) const noexcept
+	{
+		const size_t depth = mRows[row].Depth;
+		for (row++; row < mRows.size() && mRows[row].Depth > depth; row++) {}
+		return row;
+	}
+
+	void VirtualTree::OpenRow(size_t row)
+	{
+		thread_local std::vector<Row> s_Rows;
+		s_Rows.clear();
+		SetOpenBit(mRows[row].Node, true);
+		AppendRows(s_Rows, mRows[row].Node, mRows[row].Depth + 1);
+		mRows.insert(mRows.begin() + row + 1, s_Rows.begin(), s_Rows.end());
+	}
+
+	void VirtualTree::CloseRow(size_t row, bool recursive)
+	{
+		const size_t end = SubtreeEnd(row);
+		// Closing the node being expanded or one of its ancestors cancels the expansion
+		if (mExpand && mExpand->Node != Root)
+			if (const size_t job_row = FindRow(mExpand->Node); job_row >= row && job_row < end)
+				mExpand.reset();
+		if (recursive)
+			for (size_t n = row + 1; n < end; n++)
+				SetOpenBit(mRows[n].Node, false);
+		SetOpenBit(mRows[row].Node, false);
+		mRows.erase(mRows.begin() + row + 1, mRows.begin() + end);
+	}
+
+	void VirtualTree::SetOpen(size_t node, bool open)
+	{
+		if (IsOpen(node) == open)
+			return;
+		const size_t row = mRowsValid ? FindRow(node) : SIZE_MAX;
+		if (row == SIZE_MAX)
+			SetOpenBit(node, open);
+		else if (open)
+			OpenRow(row);
+		else
+			CloseRow(row, false);
+	}
+
+	void VirtualTree::ExpandAll(size_t node)
+	{
+		// The node itself opens right away; its descendants only show once they are all walked, in one splice
+		if (node != Root)
+			SetOpen(node, true);
+		mExpand.emplace();
+		mExpand->Node = node;
+		if (const size_t count = ChildCount(node))
+			mExpand->Stack.push_back({ node, 0, count });
+	}
+
+	void VirtualTree::CollapseAll(size_t node)
+	{
+		if (node == Root)
+		{
+			// Only the top level remains
+			mExpand.reset();
+			std::ranges::fill(mOpen, 0);
+			mRows.clear();
+			if (const size_t count = ChildCount(Root))
+				for (size_t i = 0; i < count; i++)
+					mRows.push_back({ ChildAt(Root, i), 0 });
+			mRowsValid = true;
+			return;
+		}
+		const size_t row = mRowsValid ? FindRow(node) : SIZE_MAX;
+		if (row == SIZE_MAX)
+		{
+			if (mExpand && mExpand->Node == node)
+				mExpand.reset();
+			SetOpenBit(node, false);
+		}
+		else
+			CloseRow(row, true);
+	}
+
+	void VirtualTree::StepExpand()
+	{
+		ExpandJob& job = *mExpand;
+		for (size_t budget = std::max<size_t>(ExpandBudget, 1); budget > 0 && !job.Stack.empty(); budget--)
+		{
+			auto& top = job.Stack.back();
+			if (top.Index == top.Count)
+			{
+				job.Stack.pop_back();
+				continue;
+			}
+			const size_t child = ChildAt(top.Node, top.Index++);
+			job.Rows.push_back({ child, job.Stack.size() - 1 });
+			if (const size_t count = ChildCount(child))
+			{
+				job.Stack.push_back({ child, 0, count });
+				job.Opened.push_back(child);
+			}
+		}
+		if (!job.Stack.empty())
+			return;
+
+		for (const size_t node : job.Opened)
+			SetOpenBit(node, true);
+
+		// The walk gave the rows of the fully open subtree, which replace the current ones (including the nodes opened or
+		// closed meanwhile, which are all open now). Draw() made the rows valid before this step.
+		IM_ASSERT(mRowsValid);
+		if (job.Node == Root)
+			mRows.swap(job.Rows);
+		else if (const size_t row = FindRow(job.Node); row != SIZE_MAX)
+		{
+			const size_t depth = mRows[row].Depth + 1;
+			for (Row& r : job.Rows)
+				r.Depth += depth;
+			mRows.erase(mRows.begin() + row + 1, mRows.begin() + SubtreeEnd(row));
+			mRows.insert(mRows.begin() + row + 1, job.Rows.begin(), job.Rows.end());
+		}
+		mExpand.reset();
+	}
+
+	void VirtualTree::Draw(ImStrv id, ImVec2 const& size)
+	{
+		// Rows are made valid first (which only walks the part of the tree that is already open), so that the ExpandAll() step
+		// can splice its rows in, and so that nodes opened or closed during the walk keep patching them
+		if (!mRowsValid)
+			RebuildRows();
+		if (mExpand)
+			StepExpand();
+
+		if (ImGui::BeginChild(id, size, ImGuiChildFlags_None, ImGuiWindowFlags_HorizontalScrollbar))
+		{
+			ImGuiContext& g = *GImGui;
+			ImGuiWindow* window = g.CurrentWindow;
+			const float start_x = ImGui::GetCursorPosX();
+			const ImU32 arrow_color = ImGui::GetColorU32(ImGuiCol_Text);
+
+			// Rows can't change while the clipper walks them, so a click is applied after
+			size_t clicked_row = SIZE_MAX;
+			bool clicked_recursive = false;
+			ImGuiListClipper clipper;
+			clipper.Begin((int)mRows.size());
+			while (clipper.Step())
+			{
+				for (int n = clipper.DisplayStart; n < clipper.DisplayEnd; n++)
+				{
+					Row const& row = mRows[n];
+					ImGui::PushOverrideID(ImHashData(&row.Node, sizeof(row.Node), window->IDStack.back()));
+					ImGui::SetCursorPosX(start_x + g.Style.IndentSpacing * float(row.Depth));
+					const ImVec2 arrow_pos = ImGui::GetCursorScreenPos();
+					if (ChildCount(row.Node) > 0)
+					{
+						if (ImGui::InvisibleButton("##Arrow", ImVec2(g.FontSize, g.FontSize)))
+						{
+							clicked_row = size_t(n);
+							clicked_recursive = g.IO.KeyCtrl;
+						}
+						ImGui::RenderArrow(window->DrawList, ImVec2(arrow_pos.x, arrow_pos.y + g.FontSize * 0.15f), arrow_color, IsOpen(row.Node) ? ImGuiDir_Down : ImGuiDir_Right, 0.70f);
+					}
+					else
+						ImGui::Dummy(ImVec2(g.FontSize, g.FontSize));
+					ImGui::SameLine(0.0f, g.Style.ItemInnerSpacing.x);
+					if (DrawNode)
+						DrawNode(row.Node);
+					else
+						Text("{}", row.Node);
+					ImGui::PopID();
+				}
+			}
+			clipper.End();
+
+			if (clicked_row != SIZE_MAX)
+			{
+				const size_t node = mRows[clicked_row].Node;
+				if (IsOpen(node))
+					CloseRow(clicked_row, clicked_recursive);
+				else if (clicked_recursive)
+					ExpandAll(node);
+				else
+					OpenRow(clicked_row);
+			}
+		}
+		ImGui::EndChild();
+	}
+
+	void SelectionStorage::ApplyRequests(ImGuiMultiSelectIO* ms_io)
+	{
+		IM_ASSERT(ms_io->ItemsCount != -1 && "Missing value for items_count in BeginMultiSelect() call!");
+		for (ImGuiSelectionRequest const& req : ms_io->Requests)
+		{
+			if (req.Type == ImGuiSelectionRequestType_SetAll)
+			{
+				Clear();
+				if (req.Selected && ms_io->ItemsCount > 0)
+					SetRangeSelected(0, ms_io->ItemsCount - 1, true);
+			}
+			else if (req.Type == ImGuiSelectionRequestType_SetRange)
+				SetRangeSelected((int)req.RangeFirstItem, (int)req.RangeLastItem, req.Selected);
+		}
+	}
+
+	bool SelectionStorage::Contains(ImGuiID id) const
+	{
+		if (!IsIndexBased())
+			return mIds.Contains(id);
+		auto it = mIntervals.upper_bound(int(id));
+		return it != mIntervals.begin() && int(id) < std::prev(it)->second;
+	}
+
+	void SelectionStorage::SetItemSelected(ImGuiID id, bool selected)
+	{
+		if (IsIndexBased())
+			SetIndexRange(int(id), int(id) + 1, selected);
+		else if (selected)
+			mIds.Insert(id);
+		else
+			mIds.Erase(id);
+	}
+
+	void SelectionStorage::SetRangeSelected(int first, int last, bool selected)
+	{
+		if (first > last)
+			std::swap(first, last);
+		if (IsIndexBased())
+			return SetIndexRange(first, last + 1, selected);
+		if (selected)
+			mIds.Reserve(mIds.Size() + size_t(last - first) + 1);
+		for (int index = first; index <= last; index++)
+			SetItemSelected(AdapterIndexToStorageId(index), selected);
+	}
+
+	void SelectionStorage::SetIndexRange(int begin, int end, bool selected)
+	{
+		if (begin >= end)
+			return;
+		// Start from the interval before `begin` if it reaches it
+		auto it = mIntervals.upper_bound(begin);
+		if (it != mIntervals.begin() && std::prev(it)->second >= begin)
+			--it;
+
+		// Selecting merges everything overlapping or touching [begin, end); deselecting cuts what overlaps it, keeping the parts outside
+		int merged_begin = begin, merged_end = end;
+		while (it != mIntervals.end() && it->first <= end)
+		{
+			const auto [b, e] = *it;
+			if (!selected && (e <= begin || b >= end))
+			{
+				++it;
+				continue;
+			}
+			mSize -= size_t(e - b);
+			it = mIntervals.erase(it);
+			if (selected)
+			{
+				merged_begin = std::min(merged_begin, b);
+				merged_end = std::max(merged_end, e);
+				continue;
+			}
+			if (b < begin)
+			{
+				mIntervals.emplace_hint(it, b, begin);
+				mSize += size_t(begin - b);
+			}
+			if (e > end)
+			{
+				mIntervals.emplace_hint(it, end, e);
+				mSize += size_t(e - end);
+			}
+		}
+		if (selected)
+		{
+			mIntervals.emplace_hint(it, merged_begin, merged_end);
+			mSize += size_t(merged_end - merged_begin);
+		}
+	}
+
+	void SelectionStorage::Clear()
+	{
+		mIntervals.clear();
+		mSize = 0;
+		mIds.Clear();
+	}
+
+	void SelectionStorage::Swap(SelectionStorage& other) noexcept
+	{
+		std::swap(AdapterIndexToStorageId, other.AdapterIndexToStorageId);
+		mIntervals.swap(other.mIntervals);
+		std::swap(mSize, other.mSize);
+		std::swap(mIds, other.mIds);
+	}
+
+	bool SelectionStorage::IdSet::Contains(ImGuiID id) const noexcept
+	{
+		if (id == 0)
+			return HasZero;
+		if (Slots.empty())
+			return false;
+		const size_t mask = Slots.size() - 1;
+		for (size_t slot = Home(id); Slots[slot] != 0; slot = (slot + 1) & mask)
+			if (Slots[slot] == id)
+				return true;
+		return false;
+	}
+
+	void SelectionStorage::IdSet::Insert(ImGuiID id)
+	{
+		if (id == 0)
+		{
+			HasZero = true;
+			return;
+		}
+		Reserve(Count + 1);
+		const size_t mask = Slots.size() - 1;
+		size_t slot = Home(id);
+		for (; Slots[slot] != 0; slot = (slot + 1) & mask)
+			if (Slots[slot] == id)
+				return;
+		Slots[slot] = id;
+		Count++;
+	}
+
+	void SelectionStorage::IdSet::Erase(ImGuiID id) noexcept
+	{
+		if (id == 0)
+		{
+			HasZero = false;
+			return;
+		}
+		if (Slots.empty())
+			return;
+		const size_t mask = Slots.size() - 1;
+		size_t hole = Home(id);
+		for (; Slots[hole] != id; hole = (hole + 1) & mask)
+			if (Slots[hole] == 0)
+				return;
+
+		// Move back the following IDs of the cluster that the hole would make unreachable
+		for (size_t slot = (hole + 1) & mask; Slots[slot] != 0; slot = (slot + 1) & mask)
+		{
+			const size_t home = Home(Slots[slot]);
+			if (((slot - home) & mask) >= ((slot - hole) & mask))
+			{
+				Slots[hole] = Slots[slot];
+				hole = slot;
+			}
+		}
+		Slots[hole] = 0;
+		Count--;
+	}
+
+	void SelectionStorage::IdSet::Reserve(size_t count)
+	{
+		if (count * 2 <= Slots.size())
+			return;
+		const size_t capacity = std::max<size_t>(std::bit_ceil(count * 2), 16);
+		IM_ASSERT(capacity <= (size_t(1) << 32));
+		std::vector<ImGuiID> old = std::exchange(Slots, std::vector<ImGuiID>(capacity));
+		mShift = 32 - std::countr_zero(capacity);
+		Count = 0;
+		const size_t mask = capacity - 1;
+		for (ImGuiID id : old)
+		{
+			if (id == 0)
+				continue;
+			size_t slot = Home(id);
+			while (Slots[slot] != 0)
+				slot = (slot + 1) & mask;
+			Slots[slot] = id;
+			Count++;
+		}
+	}
+
+	void SelectionStorage::IdSet::Clear() noexcept
+	{
+		if (Count > 0)
+			std::ranges::fill(Slots, 0);
+		Count = 0;
+		HasZero = false;
+	}
+
 	/*
 	bool ImageButtonWithText(std::function<std::shared_ptr<Texture>(intptr_t)> const& texture_getter, intptr_t arg, ImStrv label, const ImVec2& imageSize, const ImVec2& uv0, const ImVec2& uv1, int frame_padding, const ImVec4& bg_col, const ImVec4& tint_col)
 	{
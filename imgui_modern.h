@@ -9,6 +9,16 @@
 #include <chrono>
 #include <span>
 #include <functional>
+#include <vector>
+#include <string_view>
+#include <string>
+#include <format>
+#include <deque>
+#include <atomic>
+#include <memory>
+#include <bit>
+#include <optional>
+#include <map>
 #include <magic_enum.hpp>
 #include "imgui_same.h"
 
@@ -109,31 +119,40 @@ namespace ghassanpl::ig
 		return result;
 	}
 
+	/// Formats into the current context's temporary text buffer (g.TempBuffer, as ImFormatStringToTempBuffer() does) instead of a new std::string.
+	/// The buffer is grown if the text does not fit. The text is only valid until the buffer is used again (by this or by the printf-style ImGui functions).
+	ImStrv VFormatToTempBuffer(std::string_view fmt, std::format_args args);
+
+	template <typename... ARGS>
+	ImStrv FormatToTempBuffer(const std::format_string<ARGS...> fmt, ARGS&&... args)
+	{
+		return VFormatToTempBuffer(fmt.get(), std::make_format_args(args...));
+	}
+
 	template <typename... ARGS>
 	void Text(const std::format_string<ARGS...> fmt, ARGS&&... args)
 	{
-		auto s = std::format(fmt, std::forward<ARGS>(args)...);
-		ImGui::TextUnformatted(ImStrv{ s });
+		ImGui::TextUnformatted(VFormatToTempBuffer(fmt.get(), std::make_format_args(args...)));
 	}
 
 	template <typename... ARGS>
 	void TextRight(const std::format_string<ARGS...> fmt, ARGS&&... args)
 	{
-		auto s = std::format(fmt, std::forward<ARGS>(args)...);
+		auto s = VFormatToTempBuffer(fmt.get(), std::make_format_args(args...));
 		auto w = ImGui::CalcTextSize(s).x;
 
 		auto posX = ImGui::GetContentRegionMax().x - (w + ImGui::GetStyle().ItemSpacing.x);
 		ImGui::SetCursorPosX(posX);
-		ImGui::TextUnformatted(ImStrv{ s });
+		ImGui::TextUnformatted(s);
 	}
 
 
 	template <typename... ARGS>
 	void Text(ImVec4 const& color, std::string_view fmt, ARGS&&... args)
 	{
-		auto s = std::vformat(fmt, std::make_format_args(std::forward<ARGS>(args)...));
+		auto s = VFormatToTempBuffer(fmt, std::make_format_args(args...));
 		ImGui::PushStyleColor(ImGuiCol_Text, color);
-		ImGui::TextUnformatted(ImStrv{ s });
+		ImGui::TextUnformatted(s);
 		ImGui::PopStyleColor();
 	}
 
@@ -150,224 +169,131 @@ namespace ghassanpl::ig
 	bool WrapIfNoRoomFor(float min_width);
 	bool WrapIfNoRoomFor(std::string_view label, float plus = 0.0f);
 
+	/// Only formats when the tooltip is shown
 	template <typename... ARGS>
 	void SetItemTooltip(std::format_string<ARGS...> fmt, ARGS&&... args)
 	{
-		auto s = std::format(fmt, std::forward<ARGS>(args)...);
-		if (ImGui::IsItemHovered(ImGuiHoveredFlags_ForTooltip))
-		{
-			if (!ImGui::BeginTooltipEx(ImGuiTooltipFlags_OverridePrevious, ImGuiWindowFlags_None))
-				return;
-			ImGui::TextUnformatted(ImStrv{ s });
-			ImGui::EndTooltip();
-		}
+		if (!ImGui::IsItemHovered(ImGuiHoveredFlags_ForTooltip))
+			return;
+		if (!ImGui::BeginTooltipEx(ImGuiTooltipFlags_OverridePrevious, ImGuiWindowFlags_None))
+			return;
+		ImGui::TextUnformatted(VFormatToTempBuffer(fmt.get(), std::make_format_args(args...)));
+		ImGui::EndTooltip();
 	}
 
 	void BeginGroupPanel(std::string_view name, const ImVec2& size = ImVec2(0.0f, 0.0f));
 
 	void EndGroupPanel();
 
-	/// TODO: Custom content (as a callback function)
-	/// TODO: OnClick callback
-	/// TODO: Close button
-	/// TODO: OnDismiss callback
-	/// TODO: Maybe just a general event callback
-
-	/*
-	enum class ToastType
-	{
-		Normal,
-		Success,
-		Info,
-		Warning,
-		Error,
-		COUNT
-	};
+	bool VerticalToolbar(std::span<std::pair<std::string_view, std::string_view> const> const items, int& item_index);
 
-	enum class ToastPhase
+    inline void ValueColumn(ImStrv label, std::string_view desc = {}, float fract = 0.15f)
 	{
-		FadeIn,
-		Wait,
-		FadeOut,
-		Expired,
-		COUNT
-	};
-
-	inline ImVec2 ToastPadding{ 20.0f, 20.0f };
-	inline float ToastSpacing = 10.0f;
+        if (label.empty()) return;
 
-	using namespace std::chrono_literals;
+		auto rx = ig::GetRemainingX();
+		ImGui::TextUnformatted(label);
+        if (!desc.empty() && desc != "null")
+        {
+            ig::SameLine(0);
+            if (ImGui::BeginItemTooltip())
+            {
+                ImGui::PushTextWrapPos(ImGui::GetFontSize() * 35.0f);
+                ImGui::TextUnformatted(desc.data(), desc.data() + desc.size());
+                ImGui::PopTextWrapPos();
+                ImGui::EndTooltip();
+            }
+            HelpMarker(desc);
+        }
+		ig::SameLine(rx * fract + ImGui::GetCurrentWindowRead()->DC.Indent.x);
+	}
 
-	struct Toast
+	/// The values and names of an enum (from magic_enum's static tables) and the widths of the names, so the enum widgets
+	/// neither look them up nor measure them every frame.
+	/// Widths are measured once per font, font size and build of the font's atlas (so FontScale changes and rebuilt atlases are
+	/// measured again), for the last MaxFontEntries of them. They are cached per thread, so that contexts running on different threads
+	/// don't share them.
+	template <typename E>
+	requires std::is_enum_v<E>
+	struct EnumMetadata
 	{
-		using clock_type = std::chrono::system_clock;
-		using timepoint = clock_type::time_point;
-		ToastType type = ToastType::Normal;
-		std::string icon;
-		std::string title;
-		std::function<bool(Toast const&)> content_func;
-		std::string content_string;
-		std::chrono::duration<double> dismiss_time = 3s;
-		std::chrono::system_clock::time_point phase_start = std::chrono::system_clock::now();
-		ghassanpl::align ScreenAlignment = {};
-
-		std::chrono::duration<double> FadeInOutTime = 150ms;			// Fade in and out duration
-		std::chrono::duration<double> DefaultDismissTime = 3000ms;		// Auto dismiss after X ms (default, applied only of no data provided in constructors)
-		double Opacity = 1.0;
-		bool Separator = true;
+		static constexpr size_t Count = magic_enum::enum_count<E>();
+		static constexpr size_t MaxFontEntries = 8;
 
-		int WindowFlags = ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoDecoration
-		/// | ImGuiWindowFlags_NoInputs | ImGuiWindowFlags_NoNav
-			| ImGuiWindowFlags_NoBringToFrontOnFocus | ImGuiWindowFlags_NoFocusOnAppearing;
+		static constexpr auto const& Entries() noexcept { return magic_enum::enum_entries<E>(); }
+		static constexpr E Value(size_t index) noexcept { return Entries()[index].first; }
+		static constexpr std::string_view Name(size_t index) noexcept { return Entries()[index].second; }
 
-		void SetPhase(ToastPhase phase) noexcept
+		/// Width of the name of the index-th value, as ImGui::CalcTextSize() would return it with the current font
+		static float TextWidth(size_t index)
 		{
-			phase_start = mTime;
-			mPhase = phase;
+			ImGuiContext& g = *GImGui;
+			return WidthsFor(g.Font, g.FontSize)[index];
 		}
 
-		ToastPhase Phase() const noexcept { return mPhase; }
+		static void InvalidateWidths() { FontWidths().clear(); }
 
-		static std::string DefaultIconFor(ToastType type)
-		{
-			switch (type)
-			{
-			case ToastType::Normal: return {};
-			case ToastType::Success: return "\xef\x81\x98";
-			case ToastType::Warning: return "\xef\x81\xb1";
-			case ToastType::Error: return "\xef\x81\x97";
-			case ToastType::Info: return "\xef\x81\x9a";
-			}
-		}
+	private:
 
-		inline auto DefaultTitle() const noexcept -> std::string_view
+		struct FontEntry
 		{
-			if (title.empty())
-			{
-				switch (this->type)
-				{
-				case ToastType::Normal: return "";
-				case ToastType::Success: return "Success";
-				case ToastType::Warning: return "Warning";
-				case ToastType::Error: return "Error";
-				case ToastType::Info: return "Info";
-				}
-			}
-
-			return this->title;
+			ImFont* Font = nullptr;
+			int AtlasBuildCount = 0; /// ImFontAtlas::TexBuildCount of the font's atlas when measured
+			float FontSize = 0.0f;
+			std::vector<float> Widths; /// Rounded up like CalcTextSize() does
 		};
 
-		inline auto Color() const noexcept -> ImVec4
+		static std::vector<FontEntry>& FontWidths()
 		{
-			switch (this->type)
-			{
-			case ToastType::Normal: return { 1, 1, 1, 1 }; // White
-			case ToastType::Success: return { 0, 1, 0, 1 }; // Green
-			case ToastType::Warning: return { 1, 1, 0, 1 }; // Yellow
-			case ToastType::Error: return { 1, 0, 0, 1 }; // Error
-			case ToastType::Info: return { 0, 157.0f / 255.0f, 1, 1 }; // Blue
-			}
-			return {};
+			static thread_local std::vector<FontEntry> fonts;
+			return fonts;
 		}
 
-		inline auto PhaseTime() const noexcept { return mTime - this->phase_start; }
-
-		inline void Update(timepoint now)  noexcept
+		static std::vector<float> const& WidthsFor(ImFont* font, float font_size)
 		{
-			mTime = now;
-
-			const auto elapsed = PhaseTime();
-
-			switch (mPhase)
+			auto& fonts = FontWidths();
+			const int build_count = font->ContainerAtlas ? font->ContainerAtlas->TexBuildCount : 0;
+			for (auto& entry : fonts)
+				if (entry.Font == font && entry.AtlasBuildCount == build_count && entry.FontSize == font_size)
+					return entry.Widths;
+
+			if (fonts.size() >= MaxFontEntries)
+				fonts.erase(fonts.begin());
+			auto& entry = fonts.emplace_back();
+			entry.Font = font;
+			entry.AtlasBuildCount = build_count;
+			entry.FontSize = font_size;
+			entry.Widths.resize(Count);
+			for (size_t i = 0; i < Count; i++)
 			{
-			case ToastPhase::FadeIn:
-				if (elapsed > FadeInOutTime)
-					SetPhase(ToastPhase::Wait);
-				break;
-			case ToastPhase::Wait:
-				if (elapsed > this->dismiss_time)
-					SetPhase(ToastPhase::FadeOut);
-				break;
-			case ToastPhase::FadeOut:
-				if (elapsed > FadeInOutTime)
-					SetPhase(ToastPhase::Expired);
-				break;
-			case ToastPhase::Expired:
-				break;
+				const auto name = Name(i);
+				entry.Widths[i] = IM_TRUNC(font->CalcTextSizeA(font_size, FLT_MAX, 0.0f, ImStrv{ name.data(), name.data() + name.size() }).x + 0.99999f);
 			}
+			return entry.Widths;
 		}
-
-		inline auto FadePercent() const noexcept -> double
-		{
-			const auto elapsed = PhaseTime();
-
-			if (mPhase == ToastPhase::FadeIn)
-				return (elapsed / FadeInOutTime) * Opacity;
-			else if (mPhase == ToastPhase::FadeOut)
-				return (1.0 - (elapsed / FadeInOutTime)) * Opacity;
-
-			return Opacity;
-		}
-
-		//private:
-
-		timepoint mTime{};
-		ToastPhase mPhase = ToastPhase::FadeIn;
 	};
-	/// <summary>
-	/// Insert a new toast in the list
-	/// </summary>
-	size_t PushToast(Toast toast);
-
-	/// <summary>
-	/// Remove a toast from the list by its index
-	/// </summary>
-	/// <param name="index">index of the toast to remove</param>
-	void RemoveToast(size_t index);
-
-	/// <summary>
-	/// Render toasts, call at the end of your rendering!
-	/// </summary>
-	void RenderToasts();
-	*/
-
-	bool VerticalToolbar(std::span<std::pair<std::string_view, std::string_view> const> const items, int& item_index);
-
-    inline void ValueColumn(ImStrv label, std::string_view desc = {}, float fract = 0.15f)
-	{
-        if (label.empty()) return;
-
-		auto rx = ig::GetRemainingX();
-		ImGui::TextUnformatted(label);
-        if (!desc.empty() && desc != "null")
-        {
-            ig::SameLine(0);
-            if (ImGui::BeginItemTooltip())
-            {
-                ImGui::PushTextWrapPos(ImGui::GetFontSize() * 35.0f);
-                ImGui::TextUnformatted(desc.data(), desc.data() + desc.size());
-                ImGui::PopTextWrapPos();
-                ImGui::EndTooltip();
-            }
-            HelpMarker(desc);
-        }
-		ig::SameLine(rx * fract + ImGui::GetCurrentWindowRead()->DC.Indent.x);
-	}
 
+	/// Enums with many values only submit the visible ones
 	template <typename T>
 	requires std::is_enum_v<T>
 	bool EnumBox(ImStrv label, T& eval, const ImVec2& size = { 0, 0 })
 	{
+		using meta = EnumMetadata<T>;
 		bool result = false;
 		ValueColumn(label);
 		if (ImGui::BeginListBox("", size))
 		{
-			for (auto& [value, name] : magic_enum::enum_entries<T>())
+			ImGuiListClipper clipper;
+			clipper.Begin((int)meta::Count);
+			while (clipper.Step())
 			{
-				if (ImGui::Selectable(name, eval == value))
+				for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
 				{
-					eval = value;
-					result = true;
+					if (ImGui::Selectable(meta::Name(i), eval == meta::Value(i)))
+					{
+						eval = meta::Value(i);
+						result = true;
+					}
 				}
 			}
 			ImGui::EndListBox();
@@ -378,6 +304,7 @@ namespace ghassanpl::ig
 	template <typename T>
 	bool EnumCombo(ImStrv label, T& eval, const ImVec2& size = { 0, 0 })
 	{
+		using meta = EnumMetadata<T>;
 		bool result = false;
 
         ImGui::PushID(&eval);
@@ -385,12 +312,17 @@ namespace ghassanpl::ig
 
 		if (ImGui::BeginCombo("", magic_enum::enum_name(eval)))
 		{
-			for (auto& [value, name] : magic_enum::enum_entries<T>())
+			ImGuiListClipper clipper;
+			clipper.Begin((int)meta::Count);
+			while (clipper.Step())
 			{
-				if (ImGui::Selectable(name, eval == value))
+				for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
 				{
-					eval = value;
-					result = true;
+					if (ImGui::Selectable(meta::Name(i), eval == meta::Value(i)))
+					{
+						eval = meta::Value(i);
+						result = true;
+					}
 				}
 			}
 			ImGui::EndCombo();
@@ -402,13 +334,15 @@ namespace ghassanpl::ig
 	template <typename E>
 	bool EnumSelect(ImStrv label, E& eval, const ImVec2& size = { 0, 0 })
 	{
+		using meta = EnumMetadata<E>;
         ValueColumn(label);
 
 		bool result = false;
 		bool first = true;
 		ImGui::PushStyleVar(ImGuiStyleVar_SelectableTextAlign, { 0.5f, 0.5f });
 		ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, { 6.0f, 2.0f });
-		for (auto& [value, name] : magic_enum::enum_entries<E>())
+		const float extra_w = ImGui::GetStyle().ItemSpacing.x + ImGui::GetStyle().FramePadding.x * 2;
+		for (size_t i = 0; i < meta::Count; i++)
 		{
 			/*
 			if (ImGui::RadioButton(name, eval == value))
@@ -417,12 +351,12 @@ namespace ghassanpl::ig
 				result = true;
 			}
 			*/
+			auto w = meta::TextWidth(i) + extra_w;
 			//if (!std::exchange(first, false))
-				WrapIfNoRoomFor(name);
-			auto w = ImGui::CalcTextSize(name).x + ImGui::GetStyle().ItemSpacing.x + ImGui::GetStyle().FramePadding.x * 2;
-			if (ig::Selectable(name, eval == value, ImGuiSelectableFlags_NoPadWithHalfSpacing, { w, 0 }))
+				WrapIfNoRoomFor(w);
+			if (ig::Selectable(meta::Name(i), eval == meta::Value(i), ImGuiSelectableFlags_NoPadWithHalfSpacing, { w, 0 }))
 			{
-				eval = value;
+				eval = meta::Value(i);
 				result = true;
 			}
 		}
@@ -433,15 +367,18 @@ namespace ghassanpl::ig
 	template <typename E, typename V>
 	bool FlagCheckboxes(ImStrv label, enum_flags<E, V>& eval, const ImVec2& size = { 0, 0 })
 	{
+		using meta = EnumMetadata<E>;
         ValueColumn(label);
 
 		bool result = false, first = true;
-		for (auto& [value, name] : magic_enum::enum_entries<E>())
+		const float extra_w = ImGui::GetStyle().ItemSpacing.x + ImGui::GetStyle().FramePadding.x * 2 + ImGui::GetFrameHeight();
+		for (size_t i = 0; i < meta::Count; i++)
 		{
+			const E value = meta::Value(i);
 			//if (!std::exchange(first, false))
-				WrapIfNoRoomFor(name, ImGui::GetFrameHeight());
+				WrapIfNoRoomFor(meta::TextWidth(i) + extra_w);
 			bool current = eval.contains(value);
-			if (ImGui::Checkbox(name, &current))
+			if (ImGui::Checkbox(meta::Name(i), &current))
 			{
 				eval.set_to(current, value);
 				result = true;
@@ -454,15 +391,18 @@ namespace ghassanpl::ig
 	requires (std::is_integral_v<I> && !std::is_enum_v<I>)
 	bool FlagCheckboxes(ImStrv label, I& eval, const ImVec2& size = { 0, 0 })
 	{
+		using meta = EnumMetadata<E>;
         ValueColumn(label);
 
 		bool result = false, first = true;
-		for (auto& [value, name] : magic_enum::enum_entries<E>())
+		const float extra_w = ImGui::GetStyle().ItemSpacing.x + ImGui::GetStyle().FramePadding.x * 2 + ImGui::GetFrameHeight();
+		for (size_t i = 0; i < meta::Count; i++)
 		{
+			const E value = meta::Value(i);
 			//if (!std::exchange(first, false))
-				WrapIfNoRoomFor(name, ImGui::GetFrameHeight());
+				WrapIfNoRoomFor(meta::TextWidth(i) + extra_w);
 			bool current = bool(eval & (I(1) << I(value)));
-			if (ImGui::Checkbox(name, &current))
+			if (ImGui::Checkbox(meta::Name(i), &current))
 			{
 				if (current)
 					eval |= (I(1) << I(value));
@@ -475,7 +415,802 @@ namespace ghassanpl::ig
 		return result;
 	}
 
+	struct FuzzyIndex;
+
+	/// Text input proposing the first item starting with the typed text, with a popup listing the items (fuzzy filtered).
+	/// The span overload indexes `items` again when the span changes, or when the widget starts being used (input activated or popup opened)
+	/// after the items were edited in place. The index and the popup filter are kept with the context, and dropped when the widget is not
+	/// shown for io.ConfigMemoryCompactTimer seconds. Pass a FuzzyIndex built once to avoid indexing.
 	bool TextInputComboBox(ImStrv id, std::string& str, std::span<std::string_view> items, short showMaxItems = 0);
+	bool TextInputComboBox(ImStrv id, std::string& str, FuzzyIndex& items, short showMaxItems = 0);
+
+	/// Keeps a permutation of the application's rows sorted according to a table's sort specs; the rows themselves are never moved.
+	/// Register a key for each sortable column (by column index), then call Sort() with TableGetSortSpecs() every frame
+	/// and submit rows in the order given by Indices().
+	/// Keys are extracted once per sort; numeric keys are radix sorted and string keys merge sorted, each run of equal keys then
+	/// being sorted by the next key (so the sort is stable). When only the direction of the primary sort column flips,
+	/// the permutation is updated in O(n) instead of being sorted again.
+	struct TableSortEngine
+	{
+		/// Extract keys, radix sort numeric keys and merge sort string keys on multiple threads (started per sort, with at least 64k rows each)
+		bool Parallel = false;
+
+		/// Resets the permutation to the identity. Call when rows are added, removed or changed.
+		void SetRowCount(size_t count);
+		size_t RowCount() const noexcept { return mIndices.size(); }
+
+		/// `key` is called with a row index and must return an integer/enum, a floating point value or something convertible to std::string_view.
+		/// Views (std::string_view, const char*, references) must stay valid until the next call to Sort(); strings returned by value
+		/// (e.g. std::string) are copied. With Parallel set, `key` is called concurrently.
+		template <typename FUNC>
+		void SetColumnKey(int column_index, FUNC&& key)
+		{
+			using raw_result_type = std::invoke_result_t<std::remove_cvref_t<FUNC> const&, size_t>;
+			using result_type = std::remove_cvref_t<raw_result_type>;
+			if (column_index >= (int)mExtractors.size())
+				mExtractors.resize(column_index + 1);
+			auto& extractor = mExtractors[column_index];
+			extractor = {};
+			if constexpr (std::is_integral_v<result_type> || std::is_enum_v<result_type>)
+				extractor.Int = [key = std::forward<FUNC>(key)](size_t row) { return (int64_t)key(row); };
+			else if constexpr (std::is_floating_point_v<result_type>)
+				extractor.Float = [key = std::forward<FUNC>(key)](size_t row) { return (double)key(row); };
+			else if constexpr (!std::is_reference_v<raw_result_type> && !std::is_trivially_copyable_v<raw_result_type>)
+				extractor.OwnedString = [key = std::forward<FUNC>(key)](size_t row) { return std::string{ std::string_view{ key(row) } }; };
+			else
+				extractor.String = [key = std::forward<FUNC>(key)](size_t row) { return std::string_view{ key(row) }; };
+			mNeedsFullSort = true;
+		}
+
+		/// Forces a full sort on the next call to Sort(), e.g. after row contents changed.
+		void Invalidate() noexcept { mNeedsFullSort = true; }
+
+		/// Sorts if the specs are dirty (clearing SpecsDirty) or the engine was invalidated. Returns true if the order changed.
+		bool Sort(ImGuiTableSortSpecs* specs);
+
+		std::span<size_t const> Indices() const noexcept { return mIndices; }
+		size_t operator[](size_t display_index) const noexcept { return mIndices[display_index]; }
+
+		/// Keys of one sorted column, extracted for all rows
+		struct SortKey
+		{
+			int ColumnIndex = -1;
+			ImGuiSortDirection Direction = ImGuiSortDirection_Ascending;
+			std::vector<int64_t> Ints;
+			std::vector<double> Floats;
+			std::vector<std::string_view> Strings;
+			std::vector<std::string> OwnedStrings; /// Storage for Strings, for keys returning strings by value
+
+			int Compare(size_t a, size_t b) const noexcept;
+		};
+
+	private:
+
+		struct Extractor
+		{
+			std::function<int64_t(size_t)> Int;
+			std::function<double(size_t)> Float;
+			std::function<std::string_view(size_t)> String;
+			std::function<std::string(size_t)> OwnedString;
+			explicit operator bool() const noexcept { return Int || Float || String || OwnedString; }
+		};
+
+		void FullSort();
+		void FlipPrimaryDirection();
+
+		std::vector<Extractor> mExtractors;
+		std::vector<size_t> mIndices;
+		std::vector<SortKey> mKeys;
+		bool mNeedsFullSort = true;
+	};
+
+	/// Indices of the lines of a text buffer (indexed by ImGuiTextIndex) which pass an ImGuiTextFilter, to feed ImGuiListClipper
+	/// without testing every line every frame.
+	/// The filtered lines are rebuilt only when the filter text changes, on multiple threads for large buffers.
+	/// Otherwise Update() only tests the lines appended since the previous call.
+	struct TextFilterIndex
+	{
+		/// Threads used when rebuilding, 0 = std::thread::hardware_concurrency()
+		unsigned ThreadCount = 0;
+		/// Minimum number of lines given to each rebuilding thread
+		int MinLinesPerThread = 32 * 1024;
+
+		/// Call every frame, or after appending to the buffer. Returns true if the filtered lines changed.
+		bool Update(ImGuiTextFilter const& filter, const char* buf, ImGuiTextIndex& line_index);
+		bool Update(ImGuiTextFilter const& filter, ImGuiTextBuffer const& buf, ImGuiTextIndex& line_index) { return Update(filter, buf.begin(), line_index); }
+
+		/// Call when the buffer and its ImGuiTextIndex were cleared
+		void Clear();
+
+		/// Number of lines passing the filter
+		int Size() const noexcept { return (mPassAll ? mTestedLines : (int)mLines.size()) + (mLastLinePasses ? 1 : 0); }
+		/// Line number in the ImGuiTextIndex of the n-th line passing the filter
+		int LineAt(int n) const noexcept { return mPassAll ? n : n < (int)mLines.size() ? mLines[n] : mTestedLines; }
+
+		/// Runs an ImGuiListClipper over the filtered lines, calling func(line_number, line_begin, line_end) for the visible ones
+		template <typename FUNC>
+		void Clip(const char* buf, ImGuiTextIndex& line_index, FUNC&& func) const
+		{
+			ImGuiListClipper clipper;
+			clipper.Begin(Size());
+			while (clipper.Step())
+			{
+				for (int n = clipper.DisplayStart; n < clipper.DisplayEnd; n++)
+				{
+					const int line = LineAt(n);
+					func(line, line_index.get_line_begin(buf, line), line_index.get_line_end(buf, line));
+				}
+			}
+			clipper.End();
+		}
+
+	private:
+
+		void Rebuild(ImGuiTextFilter const& filter, const char* buf, ImGuiTextIndex& line_index, int complete_lines);
+
+		std::string mFilterText;
+		std::vector<int> mLines;
+		int mTestedLines = 0; /// Number of complete lines tested so far. The last line is retested until it ends with a newline.
+		bool mLastLinePasses = false;
+		bool mPassAll = true; /// Filter is inactive, mLines is not used
+	};
+
+	/// Index over a set of strings (e.g. combo items, file names) for searching as the user types.
+	/// - Prefix queries use the items sorted once (a flattened trie: the items sharing a prefix form one range, found by binary search).
+	/// - Fuzzy queries match the query's characters in order, case-insensitively, anywhere in an item, and score how well they match
+	///   (consecutive characters, word starts, start of the item). A 64-bit mask of the characters of each item rejects most items
+	///   without looking at them, and a query extending the previous one only retests the previous matches.
+	/// - Glob queries ("*.png;*.jp?g") reject items with the mask of the pattern's literal characters before matching them.
+	/// Build() once per item set; the strings are not copied and must outlive the index (or the next Build()).
+	struct FuzzyIndex
+	{
+		struct Match
+		{
+			uint32_t Item = 0; /// Index of the item, in the order given to Build()
+			int Score = 0;
+		};
+
+		void Build(std::span<std::string_view const> items);
+
+		/// `proj` maps each element of `items` to something convertible to std::string_view
+		template <typename RANGE, typename PROJ>
+		void Build(RANGE const& items, PROJ&& proj)
+		{
+			std::vector<std::string_view> views;
+			views.reserve(std::ranges::size(items));
+			for (auto const& item : items)
+				views.push_back(std::string_view{ std::invoke(proj, item) });
+			Build(std::span<std::string_view const>{ views });
+			mOwnedViews = std::move(views);
+			mItems = mOwnedViews;
+		}
+
+		/// Adds items after the existing ones, which keep their index. The index keeps its own copy of the views (which must stay valid).
+		/// Only the new items are tested against the current search query.
+		void Append(std::span<std::string_view const> items);
+
+		void Clear();
+
+		size_t Size() const noexcept { return mItems.size(); }
+		std::string_view Item(size_t index) const noexcept { return mItems[index]; }
+
+		/// Items starting with `prefix` (case-sensitive), in lexicographical order
+		std::span<uint32_t const> WithPrefix(std::string_view prefix);
+
+		/// All items fuzzy matching `query`, in item order. An empty query matches nothing.
+		std::span<Match const> Search(std::string_view query);
+		/// The (at most) `max_results` best items fuzzy matching `query`, best first
+		std::span<Match const> SearchBest(std::string_view query, size_t max_results);
+
+		/// Whether the item matches any of the ';' separated glob patterns ('*' and '?' wildcards, case-insensitive)
+		bool MatchesGlob(size_t index, std::string_view patterns) const;
+		/// Items matching any of the ';' separated glob patterns, in item order
+		void Glob(std::string_view patterns, std::vector<uint32_t>& out) const;
+
+		/// Fuzzy match score of `query` against `text`, or -1 if the characters of `query` do not all appear in order in `text`
+		static int FuzzyScore(std::string_view query, std::string_view text);
+		/// Matches a single glob pattern (no ';'), case-insensitively
+		static bool GlobMatch(std::string_view pattern, std::string_view text);
+
+	private:
+
+		std::span<std::string_view const> mItems;
+		std::vector<std::string_view> mOwnedViews;
+		std::vector<uint64_t> mMasks;
+		std::vector<uint32_t> mSorted; /// Built on first use by WithPrefix()
+		std::string mQuery;			   /// Query mMatches were found for
+		std::vector<Match> mMatches;
+		std::vector<Match> mBest;
+		bool mQueryValid = false;
+	};
+
+	/// Bounded lock-free queue for many producer threads and a single consumer (Dmitry Vyukov's bounded MPMC algorithm).
+	/// The capacity is rounded up to a power of two. TryPush() never blocks and fails when the queue is full.
+	template <typename T>
+	class BoundedMPSCQueue
+	{
+	public:
+
+		explicit BoundedMPSCQueue(size_t capacity)
+			: mCells(std::make_unique<Cell[]>(std::bit_ceil(std::max<size_t>(capacity, 2))))
+			, mMask(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1)
+		{
+			for (size_t i = 0; i <= mMask; i++)
+				mCells[i].Sequence.store(i, std::memory_order_relaxed);
+		}
+
+		size_t Capacity() const noexcept { return mMask + 1; }
+
+		/// Safe to call from any thread
+		template <typename... ARGS>
+		bool TryPush(ARGS&&... args)
+		{
+			return TryPushWith([&](T& value) { value = T{ std::forward<ARGS>(args)... }; });
+		}
+
+		/// Safe to call from any thread. `fill` is called with the claimed cell's previous value, so its storage can be reused.
+		template <typename FUNC>
+		bool TryPushWith(FUNC&& fill)
+		{
+			size_t pos = mEnqueuePos.load(std::memory_order_relaxed);
+			Cell* cell;
+			for (;;)
+			{
+				cell = &mCells[pos & mMask];
+				const size_t seq = cell->Sequence.load(std::memory_order_acquire);
+				const intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+				if (diff == 0)
+				{
+					if (mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+						break;
+				}
+				else if (diff < 0)
+					return false;
+				else
+					pos = mEnqueuePos.load(std::memory_order_relaxed);
+			}
+			fill(cell->Value);
+			cell->Sequence.store(pos + 1, std::memory_order_release);
+			return true;
+		}
+
+		/// Only call from the consumer thread. The value is swapped with `out`, whose previous contents go back to the queue for reuse.
+		bool TryPop(T& out)
+		{
+			Cell* cell = &mCells[mDequeuePos & mMask];
+			if ((intptr_t)cell->Sequence.load(std::memory_order_acquire) - (intptr_t)(mDequeuePos + 1) < 0)
+				return false;
+			std::swap(out, cell->Value);
+			cell->Sequence.store(mDequeuePos + mMask + 1, std::memory_order_release);
+			mDequeuePos++;
+			return true;
+		}
+
+	private:
+
+		struct Cell
+		{
+			std::atomic<size_t> Sequence;
+			T Value{};
+		};
+
+		std::unique_ptr<Cell[]> mCells;
+		size_t mMask;
+		alignas(64) std::atomic<size_t> mEnqueuePos = 0;
+		alignas(64) size_t mDequeuePos = 0;
+	};
+
+	enum class LogSeverity : uint8_t
+	{
+		Trace,
+		Debug,
+		Info,
+		Warning,
+		Error,
+		Critical,
+	};
+
+	/// Scrolling log widget for high-throughput streams. Any thread can Push() lines without locking; they are moved into
+	/// bounded storage by the UI thread when drawing, the oldest lines being dropped in O(1) once MaxLines or MaxBytes is exceeded.
+	/// Each line has a severity and an optional color, and only the visible lines are submitted (through ImGuiListClipper).
+	struct LogView
+	{
+		/// `queue_capacity` is the number of lines that can be pushed between two frames before pushes start failing
+		explicit LogView(size_t max_lines = 64 * 1024, size_t max_bytes = 8 * 1024 * 1024, size_t queue_capacity = 64 * 1024);
+
+		/// Safe to call from any thread. Embedded newlines split the text into several lines.
+		/// `color` overrides the severity color when non-zero. Returns false (and counts the line as dropped) if the queue is full.
+		bool Push(std::string_view text, LogSeverity severity = LogSeverity::Info, ImU32 color = 0);
+		bool Push(std::string&& text, LogSeverity severity = LogSeverity::Info, ImU32 color = 0);
+
+		/// Moves the pushed lines into storage. Called by Draw(), only call from the UI thread.
+		void Drain();
+		/// Only call from the UI thread
+		void Clear();
+
+		/// Draws the lines in a child window
+		void Draw(ImStrv id, ImVec2 const& size = ImVec2(0, 0));
+		/// Draws a filter input, a minimum severity combo, an auto-scroll checkbox and a clear button
+		void DrawOptions();
+
+		ImGuiTextFilter Filter;
+		LogSeverity MinSeverity = LogSeverity::Trace;
+		bool AutoScroll = true;
+
+		size_t LineCount() const noexcept { return mLineCount; }
+		size_t FilteredLineCount() const noexcept { return mFiltered.size(); }
+		/// Lines lost because the queue was full
+		size_t DroppedLineCount() const noexcept { return mDropped.load(std::memory_order_relaxed); }
+
+		static ImU32 SeverityColor(LogSeverity severity);
+
+	private:
+
+		struct PendingLine
+		{
+			std::string Text;
+			ImU32 Color = 0;
+			LogSeverity Severity = LogSeverity::Info;
+		};
+
+		struct Line
+		{
+			uint32_t Offset;
+			uint32_t Length;
+			ImU32 Color;
+			LogSeverity Severity;
+		};
+
+		void AppendLine(const char* text, size_t length, LogSeverity severity, ImU32 color);
+		void PopOldestLine();
+		bool PassFilter(Line const& line) const;
+		void RebuildFiltered();
+		std::string_view LineText(Line const& line) const noexcept { return { mText.data() + line.Offset, line.Length }; }
+		Line const& LineAt(uint64_t id) const noexcept { return mLines[(mFirstLine + (id - mFirstLineId)) % mLines.size()]; }
+
+		BoundedMPSCQueue<PendingLine> mQueue;
+		std::atomic<size_t> mDropped = 0;
+		PendingLine mPopped;
+
+		std::vector<Line> mLines; /// Ring of line records, mLineCount of them starting at mFirstLine
+		size_t mFirstLine = 0;
+		size_t mLineCount = 0;
+		uint64_t mFirstLineId = 0; /// Lines are identified by their sequence number since the last Clear()
+		std::vector<char> mText; /// Ring of line text; a line never wraps, the end of the buffer is skipped instead
+		size_t mTextWritePos = 0;
+
+		std::deque<uint64_t> mFiltered; /// Ids of the stored lines passing Filter and MinSeverity
+		std::string mFilterText;
+		LogSeverity mFilterSeverity = LogSeverity::Trace;
+	};
+
+	enum class ToastType : uint8_t
+	{
+		Normal,
+		Success,
+		Info,
+		Warning,
+		Error,
+		COUNT
+	};
+
+	/// TODO: Custom content (as a callback function)
+	/// TODO: OnClick callback
+
+	/// Notification toasts stacked in the bottom right corner of the main viewport.
+	/// Any thread can Push() without locking or allocating: the text is copied (truncated if needed) into a cell of a bounded lock-free queue.
+	/// Render() drains the queue on the UI thread. A push repeating a toast still on screen is coalesced into it (and counted);
+	/// pushes over the rate limit are counted into a single summary toast. Toasts live in a fixed pool, the oldest being replaced when it is full.
+	struct ToastManager
+	{
+		static constexpr size_t MaxTitleLength = 63;
+		static constexpr size_t MaxContentLength = 255;
+
+		/// `queue_capacity` is the number of toasts that can be pushed between two frames before pushes start failing
+		explicit ToastManager(size_t pool_size = 16, size_t queue_capacity = 1024);
+
+		/// Safe to call from any thread. A zero `display_time` uses DisplayTime.
+		/// Returns false (and counts the toast as dropped) if the queue is full.
+		bool Push(ToastType type, std::string_view title, std::string_view content = {}, std::chrono::milliseconds display_time = {});
+
+		/// Takes in the pushed toasts, then lays out and draws the visible ones. Call once per frame from the UI thread, at the end of your rendering.
+		void Render();
+		/// Fades out every toast. Only call from the UI thread.
+		void DismissAll();
+
+		ImVec2 Padding{ 20.0f, 20.0f };
+		float Spacing = 10.0f;
+		float WrapWidthFraction = 1.0f / 3.0f; /// Text wraps at this fraction of the viewport width
+		std::chrono::milliseconds FadeTime{ 150 };
+		std::chrono::milliseconds DisplayTime{ 3000 };
+		float MaxPerSecond = 10.0f; /// Rate limit of new toasts (token bucket)...
+		float MaxBurst = 8.0f;		/// ...and how many can appear at once
+		bool Separator = true;
+		ImGuiWindowFlags WindowFlags = ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoBringToFrontOnFocus | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoSavedSettings;
+
+		size_t VisibleCount() const noexcept { return mOrder.size(); }
+		/// Toasts lost because the queue was full
+		size_t DroppedCount() const noexcept { return mDropped.load(std::memory_order_relaxed); }
+		/// Pushes merged into a toast already shown
+		size_t CoalescedCount() const noexcept { return mCoalesced; }
+		/// Pushes over the rate limit
+		size_t SuppressedCount() const noexcept { return mSuppressed; }
+
+		static ImVec4 Color(ToastType type) noexcept;
+		static std::string_view DefaultTitle(ToastType type) noexcept;
+		static std::string_view DefaultIcon(ToastType type) noexcept;
+
+	private:
+
+		using clock = std::chrono::steady_clock;
+
+		struct Request
+		{
+			ImGuiID Hash = 0;
+			uint32_t DisplayMs = 0;
+			ToastType Type = ToastType::Normal;
+			uint8_t TitleLength = 0;
+			uint16_t ContentLength = 0;
+			char Title[MaxTitleLength + 1];
+			char Content[MaxContentLength + 1];
+
+			std::string_view TitleText() const noexcept { return { Title, TitleLength }; }
+			std::string_view ContentText() const noexcept { return { Content, ContentLength }; }
+			bool SameText(Request const& other) const noexcept { return Type == other.Type && TitleText() == other.TitleText() && ContentText() == other.ContentText(); }
+		};
+
+		struct Slot
+		{
+			Request Toast;
+			clock::time_point Start;	/// Fade in start; moved back when a push is coalesced so the toast stays opaque
+			clock::time_point End;		/// Fade out start
+			uint32_t Count = 0;			/// Pushes shown by this toast, 0 when the slot is free
+			char WindowName[16];
+		};
+
+		Slot& Show(Request const& request, clock::time_point now);
+		void UpdateSummary(clock::time_point now);
+
+		BoundedMPSCQueue<Request> mQueue;
+		std::atomic<size_t> mDropped = 0;
+		Request mPopped;
+
+		std::vector<Slot> mSlots;
+		std::vector<uint32_t> mOrder; /// Slots in use, oldest first
+		size_t mCoalesced = 0;
+		size_t mSuppressed = 0;
+		size_t mSuppressedSummarized = 0;
+		float mTokens = 0.0f;
+		clock::time_point mLastRefill{};
+	};
+
+	/// The ToastManager of `ctx` (the current context if null), used by PushToast() and RenderToasts(). Created on first use, destroyed with the context.
+	/// Only call from the UI thread: other threads push through the reference it returns.
+	ToastManager& Toasts(ImGuiContext* ctx = nullptr);
+
+	/// Pushes to the current context's toasts; from other threads, use Toasts().Push() on a reference taken on the UI thread
+	inline bool PushToast(ToastType type, std::string_view title, std::string_view content = {}, std::chrono::milliseconds display_time = {}) { return Toasts().Push(type, title, content, display_time); }
+	/// Call at the end of your rendering!
+	inline void RenderToasts() { Toasts().Render(); }
+
+	/// Smallest and largest of some values, ignoring NaNs. Empty when Min > Max.
+	struct ValueRange
+	{
+		float Min = FLT_MAX;
+		float Max = -FLT_MAX;
+
+		bool Empty() const noexcept { return Min > Max; }
+		void Add(float v) noexcept { Min = v < Min ? v : Min; Max = v > Max ? v : Max; }
+		void Add(ValueRange const& other) noexcept { Min = std::min(Min, other.Min); Max = std::max(Max, other.Max); }
+	};
+
+	/// Vectorizable min/max scan of contiguous values, NaNs are skipped
+	ValueRange ValueRangeOf(std::span<float const> values) noexcept;
+
+	/// Min/max pyramid over a series that doesn't change (often), so a plot can decimate it in O(width * log(size)) instead of O(size).
+	/// The values aren't kept: pass the same ones to MinMax() that were given to Build().
+	struct PlotSummary
+	{
+		static constexpr size_t BlockSize = 16; /// Samples summarized by each entry of the finest level
+
+		void Build(std::span<float const> values);
+		void Clear();
+
+		size_t Size() const noexcept { return mSize; }
+
+		/// Range of `values[begin, end)`
+		ValueRange MinMax(std::span<float const> values, size_t begin, size_t end) const;
+
+	private:
+
+		size_t mSize = 0;
+		std::vector<ValueRange> mBlocks; /// All levels, finest first, each level having a block twice as large as the previous one
+		std::vector<size_t> mLevelOffsets;
+	};
+
+	/// Like ImGui::PlotLines() and ImGui::PlotHistogram(), but drawing at most one min/max column per pixel, so spikes are never lost
+	/// and plotting a million values costs a scan of them (or, with a `summary` built from the values, about the width of the plot).
+	/// Returns the index of the first value of the hovered column, or -1.
+	int PlotLines(ImStrv label, std::span<float const> values, PlotSummary const* summary = nullptr, ImStrv overlay_text = {}, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = {});
+	int PlotHistogram(ImStrv label, std::span<float const> values, PlotSummary const* summary = nullptr, ImStrv overlay_text = {}, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = {});
+
+	/// Plot of the latest `history` values of a stream, e.g. a telemetry channel.
+	/// Any thread can Push() values without locking; they go through a bounded lock-free queue into a ring on the UI thread.
+	/// The ring keeps a min/max tree over its slots, updated in O(log(history)) per value, which gives the running range of the whole
+	/// history in O(1) and the range of each plotted column in O(log(history)), so a frame costs about the width of the plot, not the history.
+	struct StreamingPlot
+	{
+		explicit StreamingPlot(size_t history, size_t queue_capacity = 1024);
+
+		/// Safe to call from any thread. Returns false (and counts the value as dropped) if the queue is full.
+		bool Push(float value);
+
+		/// Takes in the pushed values and draws them, oldest on the left. Returns the index of the first value of the hovered column, or -1.
+		int Draw(ImStrv label, ImStrv overlay_text = {}, float scale_min = FLT_MAX, float scale_max = FLT_MAX, ImVec2 graph_size = {});
+
+		/// Only call from the UI thread
+		void Clear();
+
+		ImGuiPlotType PlotType = ImGuiPlotType_Lines;
+
+		size_t Size() const noexcept { return mSize; }
+		size_t Capacity() const noexcept { return mValues.size(); }
+		/// The `index`-th oldest value
+		float Value(size_t index) const noexcept { return mValues[(mHead + index) % mValues.size()]; }
+		/// Range of all the values in the history
+		ValueRange Range() const noexcept { return mTree[1]; }
+		/// Range of the values [begin, end), oldest first
+		ValueRange Range(size_t begin, size_t end) const noexcept;
+		/// Values lost because the queue was full
+		size_t DroppedCount() const noexcept { return mDropped.load(std::memory_order_relaxed); }
+
+	private:
+
+		void Drain();
+		void Set(size_t slot, float value) noexcept;
+		ValueRange SlotRange(size_t begin, size_t end) const noexcept;
+
+		BoundedMPSCQueue<float> mQueue;
+		std::atomic<size_t> mDropped = 0;
+
+		std::vector<float> mValues; /// Ring
+		size_t mHead = 0;			/// Slot of the oldest value
+		size_t mSize = 0;
+		size_t mLeaves = 0;
+		std::vector<ValueRange> mTree; /// Implicit binary tree, node `i` having children `2i` and `2i + 1`; leaf `mLeaves + slot` holds the value in `slot`
+	};
+
+	/// CPU-side RGBA image shown through a single texture, e.g. a large heatmap, without a quad per cell.
+	/// Writes mark the 64x64 tiles they touch as dirty; Upload() sends only those through io.RendererUpdateTextureFn,
+	/// with runs of dirty tiles merged into rects. Needs a renderer backend with ImGuiBackendFlags_RendererHasTextureUpdates.
+	/// The texture belongs to the context current when it was first uploaded. It is destroyed with the surface, or with the context if that goes
+	/// first (the next Upload() then creates one in the context current at that time).
+	struct ImageSurface
+	{
+		static constexpr int TileSize = 64;
+
+		ImageSurface(int width, int height, ImU32 color = IM_COL32_BLACK);
+		~ImageSurface();
+
+		ImageSurface(ImageSurface const&) = delete;
+		ImageSurface& operator=(ImageSurface const&) = delete;
+
+		int Width() const noexcept { return mWidth; }
+		int Height() const noexcept { return mHeight; }
+		ImVec2 Size() const noexcept { return { float(mWidth), float(mHeight) }; }
+		/// Bytes between rows
+		int Pitch() const noexcept { return mWidth * int(sizeof(ImU32)); }
+		ImU32 const* Pixels() const noexcept { return mPixels.data(); }
+		/// For writing directly; call MarkDirty() for what was written
+		ImU32* Pixels() noexcept { return mPixels.data(); }
+		ImU32 Pixel(int x, int y) const noexcept { return mPixels[size_t(y) * mWidth + x]; }
+
+		void SetPixel(int x, int y, ImU32 color) noexcept;
+		void Fill(ImU32 color) { Fill(0, 0, mWidth, mHeight, color); }
+		void Fill(int x, int y, int w, int h, ImU32 color);
+		/// Maps `values` (`w` by `h`, row-major) from [scale_min, scale_max] through `colormap` (defaults to HeatmapColormap()) into the rect at `x`, `y`
+		void Heatmap(int x, int y, int w, int h, std::span<float const> values, float scale_min, float scale_max, std::span<ImU32 const> colormap = {});
+		void Heatmap(std::span<float const> values, float scale_min, float scale_max, std::span<ImU32 const> colormap = {}) { Heatmap(0, 0, mWidth, mHeight, values, scale_min, scale_max, colormap); }
+
+		/// Clipped to the surface
+		void MarkDirty(int x, int y, int w, int h);
+		bool IsDirty() const noexcept { return mDirtyCount > 0; }
+		/// Tile-aligned (except at the right and bottom edges), non-overlapping rects covering the dirty tiles
+		std::span<ImTextureRect const> DirtyRects();
+
+		/// Creates the texture if needed and sends the dirty rects to it. Returns false if the renderer can't update textures.
+		bool Upload();
+		/// Uploads and draws the surface as a single image; a size of 0 stands for the surface's
+		void Image(ImVec2 size = {}, ImVec4 const& tint_col = { 1, 1, 1, 1 }, ImVec4 const& border_col = {});
+		/// Null until the first Upload()
+		ImTextureID TextureID() const noexcept { return mTexture; }
+
+		/// 256 colors from dark blue to yellow (viridis-like)
+		static std::span<ImU32 const> HeatmapColormap() noexcept;
+
+	private:
+
+		friend struct ImageSurfaceRegistry;
+		void DestroyTexture();
+
+		std::vector<ImU32> mPixels;
+		int mWidth = 0;
+		int mHeight = 0;
+		int mTilesX = 0;
+		int mTilesY = 0;
+		std::vector<uint64_t> mDirtyTiles; /// Bitset, tile `ty * mTilesX + tx`
+		size_t mDirtyCount = 0;
+		std::vector<ImTextureRect> mDirtyRects;
+		bool mDirtyRectsValid = false;
+
+		ImGuiContext* mContext = nullptr;
+		ImTextureID mTexture{};
+	};
+
+	/// Tree of up to millions of nodes, drawn like TreeNode()s but only for the rows in view (through ImGuiListClipper).
+	/// Nodes are indices in [0, NodeCount()); ChildCount and ChildAt give their children, `Root` standing for the top level.
+	/// Open nodes are kept in a bitset instead of the window storage, and the rows of the expanded part of the tree in a flat list
+	/// that is only patched when a node opens or closes. ExpandAll() walks big subtrees over several frames.
+	/// Ctrl+clicking an arrow expands or collapses the whole subtree.
+	struct VirtualTree
+	{
+		static constexpr size_t Root = SIZE_MAX;
+
+		explicit VirtualTree(size_t node_count = 0);
+
+		/// Number of children of `node`, or of top-level nodes for `Root`
+		std::function<size_t(size_t node)> ChildCount;
+		/// The `index`-th child of `node`, or top-level node for `Root`
+		std::function<size_t(size_t node, size_t index)> ChildAt;
+		/// Draws a row after its arrow, in the node's ID scope; draws the node index if not set
+		std::function<void(size_t node)> DrawNode;
+
+		/// Nodes visited per frame by ExpandAll()
+		size_t ExpandBudget = 64 * 1024;
+
+		/// Draws the rows in a child window. Continues ExpandAll() first.
+		void Draw(ImStrv id, ImVec2 const& size = ImVec2(0, 0));
+
+		size_t NodeCount() const noexcept { return mNodeCount; }
+		/// Call when nodes were added or removed; keeps the open state of the nodes below `node_count`
+		void SetNodeCount(size_t node_count);
+		/// Call when the children of some nodes changed; the rows are rebuilt on the next Draw(), and an ExpandAll() in progress restarts
+		void Invalidate();
+
+		bool IsOpen(size_t node) const noexcept { return node < mNodeCount && (mOpen[node / 64] >> (node % 64)) & 1; }
+		void SetOpen(size_t node, bool open);
+		/// Opens `node` and all of its descendants, at most ExpandBudget nodes per frame.
+		/// Nodes opened or closed meanwhile show right away, and end up open with the rest; closing `node` or one of its ancestors cancels it.
+		void ExpandAll(size_t node = Root);
+		/// Closes `node` and its shown descendants (the whole tree for `Root`)
+		void CollapseAll(size_t node = Root);
+		/// Whether an ExpandAll() is still in progress
+		bool IsExpanding() const noexcept { return mExpand.has_value(); }
+
+		/// Rows of the expanded part of the tree, in display order. Only valid after Draw() or RebuildRows().
+		size_t RowCount() const noexcept { return mRows.size(); }
+		size_t RowNode(size_t row) const noexcept { return mRows[row].Node; }
+		size_t RowDepth(size_t row) const noexcept { return mRows[row].Depth; }
+		void RebuildRows();
+
+	private:
+
+		struct Row
+		{
+			size_t Node;
+			size_t Depth;
+		};
+
+		struct ExpandJob
+		{
+			struct Frame
+			{
+				size_t Node;
+				size_t Index;
+				size_t Count;
+			};
+			size_t Node;
+			std::vector<Frame> Stack;
+			std::vector<Row> Rows; /// Rows of the descendants of Node once all open, built in display order
+			std::vector<size_t> Opened; /// Descendants with children, opened when the walk is done
+		};
+
+		void SetOpenBit(size_t node, bool open) noexcept;
+		void AppendRows(std::vector<Row>& rows, size_t node, size_t depth) const;
+		size_t FindRow(size_t node) const noexcept;
+		size_t SubtreeEnd(size_t row) const noexcept;
+		void OpenRow(size_t row);
+		void CloseRow(size_t row, bool recursive);
+		void StepExpand();
+
+		size_t mNodeCount = 0;
+		std::vector<uint64_t> mOpen;
+		std::vector<Row> mRows;
+		bool mRowsValid = false;
+		std::optional<ExpandJob> mExpand;
+	};
+
+	/// Multi-selection storage for lists of millions of items, applying the requests of BeginMultiSelect()/EndMultiSelect() like ImGuiSelectionBasicStorage.
+	/// Without an AdapterIndexToStorageId, items are identified by their index and the selection is kept as disjoint [begin, end) index intervals:
+	/// a SetRange or SetAll request costs O(log(intervals)) plus the intervals it swallows, whatever its number of items, and so does Contains().
+	/// With an AdapterIndexToStorageId, items are identified by ID and kept in a flat hash set, so requests cost O(items in range) with no sort.
+	/// Selection order isn't kept.
+	struct SelectionStorage
+	{
+		/// Leave empty for index-based items
+		std::function<ImGuiID(int index)> AdapterIndexToStorageId;
+
+		/// Uses the `items_count` given to BeginMultiSelect()
+		void ApplyRequests(ImGuiMultiSelectIO* ms_io);
+
+		/// `id` is an index for index-based items
+		bool Contains(ImGuiID id) const;
+		void SetItemSelected(ImGuiID id, bool selected);
+		/// Selects or deselects indices [first, last]
+		void SetRangeSelected(int first, int last, bool selected);
+		void Clear();
+		void Swap(SelectionStorage& other) noexcept;
+
+		size_t Size() const noexcept { return IsIndexBased() ? mSize : mIds.Size(); }
+		bool IsIndexBased() const noexcept { return !AdapterIndexToStorageId; }
+
+		/// Calls `func(ImGuiID)` for each selected item; in increasing order for index-based items
+		template <typename FUNC>
+		void ForEach(FUNC&& func) const
+		{
+			if (IsIndexBased())
+			{
+				for (auto [begin, end] : mIntervals)
+					for (int index = begin; index < end; index++)
+						func(ImGuiID(index));
+			}
+			else
+			{
+				if (mIds.HasZero)
+					func(ImGuiID(0));
+				for (ImGuiID id : mIds.Slots)
+					if (id != 0)
+						func(id);
+			}
+		}
+		/// Calls `func(int begin, int end)` for each run of selected indices, in increasing order. Only for index-based items.
+		template <typename FUNC>
+		void ForEachRange(FUNC&& func) const
+		{
+			IM_ASSERT(IsIndexBased());
+			for (auto [begin, end] : mIntervals)
+				func(begin, end);
+		}
+		size_t RangeCount() const noexcept { return mIntervals.size(); }
+
+	private:
+
+		/// Open addressing with linear probing and backward-shift deletion; 0 marks empty slots, so it is tracked apart
+		struct IdSet
+		{
+			std::vector<ImGuiID> Slots;
+			size_t Count = 0;
+			bool HasZero = false;
+
+			size_t Size() const noexcept { return Count + HasZero; }
+			size_t Home(ImGuiID id) const noexcept { return size_t((id * 0x9E3779B1u) >> mShift); }
+			bool Contains(ImGuiID id) const noexcept;
+			void Insert(ImGuiID id);
+			void Erase(ImGuiID id) noexcept;
+			/// Keeps the load factor at most 1/2 for `count` IDs
+			void Reserve(size_t count);
+			void Clear() noexcept;
+
+		private:
+			int mShift = 32;
+		};
+
+		void SetIndexRange(int begin, int end, bool selected);
+
+		std::map<int, int> mIntervals; /// begin -> end, disjoint and not touching
+		size_t mSize = 0;
+		IdSet mIds;
+	};
 
 	inline bool SmallButton(ImStrv label, float width)
 	{
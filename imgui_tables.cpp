@@ -3516,6 +3516,8 @@ void ImGui::TableDrawDefaultContextMenu(ImGuiTable* table, ImGuiTableFlags flags
 // - TableSettingsHandler_ReadOpen() [Internal]
 // - TableSettingsHandler_ReadLine() [Internal]
 // - TableSettingsHandler_WriteAll() [Internal]
+// - TableSettingsHandler_ReadBinary() [Internal]
+// - TableSettingsHandler_WriteBinary() [Internal]
 // - TableSettingsInstallHandler() [Internal]
 //-------------------------------------------------------------------------
 // [Init] 1: TableSettingsHandler_ReadXXXX()   Load and parse .ini file into TableSettings.
@@ -3547,18 +3549,19 @@ ImGuiTableSettings* ImGui::TableSettingsCreate(ImGuiID id, int columns_count)
     ImGuiContext& g = *GImGui;
     ImGuiTableSettings* settings = g.SettingsTables.alloc_chunk(TableSettingsCalcChunkSize(columns_count));
     TableSettingsInit(settings, id, columns_count, columns_count);
+    g.SettingsTablesMap.SetInt(id, g.SettingsTables.offset_from_ptr(settings));
     return settings;
 }
 
 // Find existing settings
 ImGuiTableSettings* ImGui::TableSettingsFindByID(ImGuiID id)
 {
-    // FIXME-OPT: Might want to store a lookup map for this?
     ImGuiContext& g = *GImGui;
-    for (ImGuiTableSettings* settings = g.SettingsTables.begin(); settings != NULL; settings = g.SettingsTables.next_chunk(settings))
-        if (settings->ID == id)
-            return settings;
-    return NULL;
+    const int offset = g.SettingsTablesMap.GetInt(id, 0);
+    if (offset == 0)
+        return NULL;
+    ImGuiTableSettings* settings = g.SettingsTables.ptr_from_offset(offset);
+    return (settings->ID == id) ? settings : NULL;
 }
 
 // Get settings for a given table, NULL if none
@@ -3637,7 +3640,7 @@ void ImGui::TableSaveSettings(ImGuiTable* table)
     settings->SaveFlags &= table->Flags;
     settings->RefScale = save_ref_scale ? table->RefScale : 0.0f;
 
-    MarkIniSettingsDirty();
+    MarkIniSettingsDirty(g.SettingsHandlerTable);
 }
 
 void ImGui::TableLoadSettings(ImGuiTable* table)
@@ -3712,6 +3715,7 @@ static void TableSettingsHandler_ClearAll(ImGuiContext* ctx, ImGuiSettingsHandle
         if (ImGuiTable* table = g.Tables.TryGetMapData(i))
             table->SettingsOffset = -1;
     g.SettingsTables.clear();
+    g.SettingsTablesMap.Clear();
 }
 
 // Apply to existing windows (if any)
@@ -3726,13 +3730,8 @@ static void TableSettingsHandler_ApplyAll(ImGuiContext* ctx, ImGuiSettingsHandle
         }
 }
 
-static void* TableSettingsHandler_ReadOpen(ImGuiContext*, ImGuiSettingsHandler*, const char* name)
+static ImGuiTableSettings* TableSettingsHandler_FindOrCreate(ImGuiID id, int columns_count)
 {
-    ImGuiID id = 0;
-    int columns_count = 0;
-    if (sscanf(name, "0x%08X,%d", &id, &columns_count) < 2)
-        return NULL;
-
     if (ImGuiTableSettings* settings = ImGui::TableSettingsFindByID(id))
     {
         if (settings->ColumnsCountMax >= columns_count)
@@ -3745,6 +3744,15 @@ static void* TableSettingsHandler_ReadOpen(ImGuiContext*, ImGuiSettingsHandler*,
     return ImGui::TableSettingsCreate(id, columns_count);
 }
 
+static void* TableSettingsHandler_ReadOpen(ImGuiContext*, ImGuiSettingsHandler*, const char* name)
+{
+    ImGuiID id = 0;
+    int columns_count = 0;
+    if (sscanf(name, "0x%08X,%d", &id, &columns_count) < 2)
+        return NULL;
+    return TableSettingsHandler_FindOrCreate(id, columns_count);
+}
+
 static void TableSettingsHandler_ReadLine(ImGuiContext*, ImGuiSettingsHandler*, void* entry, const char* line)
 {
     // "Column 0  UserID=0x42AD2D21 Width=100 Visible=1 Order=0 Sort=0v"
@@ -3812,6 +3820,70 @@ static void TableSettingsHandler_WriteAll(ImGuiContext* ctx, ImGuiSettingsHandle
     }
 }
 
+// Binary entry (version 1): ImGuiID ID, ImS16 ColumnsCount, ImS32 SaveFlags, float RefScale,
+// then for each column: float WidthOrWeight, ImGuiID UserID, ImS16 DisplayOrder, ImS16 SortOrder, ImU8 Flags (bits 0-1: SortDirection, 2: IsEnabled, 3: IsStretch)
+static void TableSettingsHandler_ReadBinary(ImGuiContext*, ImGuiSettingsHandler*, int, ImGuiSettingsBinaryReader* reader)
+{
+    while (!reader->IsEnd())
+    {
+        const ImGuiID id = reader->Read<ImGuiID>();
+        const int columns_count = reader->Read<ImS16>();
+        const ImGuiTableFlags save_flags = reader->Read<ImS32>();
+        const float ref_scale = reader->Read<float>();
+        if (reader->Overflow || id == 0 || columns_count <= 0 || columns_count > IMGUI_TABLE_MAX_COLUMNS)
+            return;
+
+        ImGuiTableSettings* settings = TableSettingsHandler_FindOrCreate(id, columns_count);
+        settings->SaveFlags = save_flags;
+        settings->RefScale = ref_scale;
+        ImGuiTableColumnSettings* column = settings->GetColumnSettings();
+        for (int column_n = 0; column_n < columns_count; column_n++, column++)
+        {
+            column->Index = (ImGuiTableColumnIdx)column_n;
+            column->WidthOrWeight = reader->Read<float>();
+            column->UserID = reader->Read<ImGuiID>();
+            column->DisplayOrder = (ImGuiTableColumnIdx)reader->Read<ImS16>();
+            column->SortOrder = (ImGuiTableColumnIdx)reader->Read<ImS16>();
+            const ImU8 flags = reader->Read<ImU8>();
+            column->SortDirection = flags & 0x03;
+            column->IsEnabled = (flags >> 2) & 1;
+            column->IsStretch = (flags >> 3) & 1;
+        }
+        if (reader->Overflow)
+        {
+            settings->ID = 0; // Truncated data: discard this entry
+            return;
+        }
+    }
+}
+
+static void TableSettingsHandler_WriteBinary(ImGuiContext* ctx, ImGuiSettingsHandler*, ImGuiTextBuffer* buf)
+{
+    ImGuiContext& g = *ctx;
+    for (ImGuiTableSettings* settings = g.SettingsTables.begin(); settings != NULL; settings = g.SettingsTables.next_chunk(settings))
+    {
+        if (settings->ID == 0) // Skip ditched settings
+            continue;
+        if ((settings->SaveFlags & (ImGuiTableFlags_Resizable | ImGuiTableFlags_Hideable | ImGuiTableFlags_Reorderable | ImGuiTableFlags_Sortable)) == 0)
+            continue;
+
+        buf->reserve(buf->size() + 14 + settings->ColumnsCount * 13); // exact reserve
+        ImGuiSettingsBinaryWrite(buf, settings->ID);
+        ImGuiSettingsBinaryWrite(buf, (ImS16)settings->ColumnsCount);
+        ImGuiSettingsBinaryWrite(buf, (ImS32)settings->SaveFlags);
+        ImGuiSettingsBinaryWrite(buf, settings->RefScale);
+        ImGuiTableColumnSettings* column = settings->GetColumnSettings();
+        for (int column_n = 0; column_n < settings->ColumnsCount; column_n++, column++)
+        {
+            ImGuiSettingsBinaryWrite(buf, column->WidthOrWeight);
+            ImGuiSettingsBinaryWrite(buf, column->UserID);
+            ImGuiSettingsBinaryWrite(buf, (ImS16)column->DisplayOrder);
+            ImGuiSettingsBinaryWrite(buf, (ImS16)column->SortOrder);
+            ImGuiSettingsBinaryWrite(buf, (ImU8)(column->SortDirection | (column->IsEnabled << 2) | (column->IsStretch << 3)));
+        }
+    }
+}
+
 void ImGui::TableSettingsAddSettingsHandler()
 {
     ImGuiSettingsHandler ini_handler;
@@ -3822,6 +3894,9 @@ void ImGui::TableSettingsAddSettingsHandler()
     ini_handler.ReadLineFn = TableSettingsHandler_ReadLine;
     ini_handler.ApplyAllFn = TableSettingsHandler_ApplyAll;
     ini_handler.WriteAllFn = TableSettingsHandler_WriteAll;
+    ini_handler.ReadBinaryFn = TableSettingsHandler_ReadBinary;
+    ini_handler.WriteBinaryFn = TableSettingsHandler_WriteBinary;
+    ini_handler.BinaryVersion = 1;
     AddSettingsHandler(&ini_handler);
 }
 
@@ -3883,6 +3958,11 @@ void ImGui::TableGcCompactSettings()
         if (settings->ID != 0)
             memcpy(new_chunk_stream.alloc_chunk(TableSettingsCalcChunkSize(settings->ColumnsCount)), settings, TableSettingsCalcChunkSize(settings->ColumnsCount));
     g.SettingsTables.swap(new_chunk_stream);
+
+    // Offsets have changed
+    g.SettingsTablesMap.Clear();
+    for (ImGuiTableSettings* settings = g.SettingsTables.begin(); settings != NULL; settings = g.SettingsTables.next_chunk(settings))
+        g.SettingsTablesMap.SetInt(settings->ID, g.SettingsTables.offset_from_ptr(settings));
 }
 
 
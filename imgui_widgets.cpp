@@ -4757,10 +4757,10 @@ bool ImGui::InputTextEx(ImStrv label, ImStrv hint, char* buf, int buf_size, cons
                 const int ib = state->HasSelection() ? ImMin(state->Stb.select_start, state->Stb.select_end) : 0;
                 const int ie = state->HasSelection() ? ImMax(state->Stb.select_start, state->Stb.select_end) : state->CurLenW;
                 const int clipboard_data_len = ImTextCountUtf8BytesFromStr(state->TextW.Data + ib, state->TextW.Data + ie) + 1;
-                char* clipboard_data = (char*)IM_ALLOC(clipboard_data_len * sizeof(char));
+                char* clipboard_data = (char*)MemAllocTransient(clipboard_data_len * sizeof(char));
                 ImTextStrToUtf8(clipboard_data, clipboard_data_len, state->TextW.Data + ib, state->TextW.Data + ie);
                 SetClipboardText(clipboard_data);
-                MemFree(clipboard_data);
+                MemFreeTransient(clipboard_data);
             }
             if (is_cut)
             {
@@ -4776,7 +4776,7 @@ bool ImGui::InputTextEx(ImStrv label, ImStrv hint, char* buf, int buf_size, cons
             {
                 // Filter pasted buffer
                 const int clipboard_len = (int)clipboard.length();
-                ImWchar* clipboard_filtered = (ImWchar*)IM_ALLOC((clipboard_len + 1) * sizeof(ImWchar));
+                ImWchar* clipboard_filtered = (ImWchar*)MemAllocTransient((clipboard_len + 1) * sizeof(ImWchar));
                 int clipboard_filtered_len = 0;
                 for (const char* s = clipboard.Begin; *s; )
                 {
@@ -4792,7 +4792,7 @@ bool ImGui::InputTextEx(ImStrv label, ImStrv hint, char* buf, int buf_size, cons
                     stb_textedit_paste(state, &state->Stb, clipboard_filtered, clipboard_filtered_len);
                     state->CursorFollow = true;
                 }
-                MemFree(clipboard_filtered);
+                MemFreeTransient(clipboard_filtered);
             }
         }
 
@@ -4825,13 +4825,16 @@ bool ImGui::InputTextEx(ImStrv label, ImStrv hint, char* buf, int buf_size, cons
                 apply_new_text = state->InitialTextA.Data;
                 apply_new_text_length = state->InitialTextA.Size - 1;
                 value_changed = true;
-                ImVector<ImWchar> w_text;
+                ImWchar* w_text = NULL;
+                int w_text_len = 0;
                 if (apply_new_text_length > 0)
                 {
-                    w_text.resize(ImTextCountCharsFromUtf8(apply_new_text, apply_new_text + apply_new_text_length) + 1);
-                    ImTextStrFromUtf8(w_text.Data, w_text.Size, apply_new_text, apply_new_text + apply_new_text_length);
+                    w_text_len = ImTextCountCharsFromUtf8(apply_new_text, apply_new_text + apply_new_text_length);
+                    w_text = (ImWchar*)MemAllocTransient((w_text_len + 1) * sizeof(ImWchar));
+                    ImTextStrFromUtf8(w_text, w_text_len + 1, apply_new_text, apply_new_text + apply_new_text_length);
                 }
-                stb_textedit_replace(state, &state->Stb, w_text.Data, (apply_new_text_length > 0) ? (w_text.Size - 1) : 0);
+                stb_textedit_replace(state, &state->Stb, w_text, w_text_len);
+                MemFreeTransient(w_text);
             }
         }
 
@@ -5597,6 +5600,106 @@ static void RenderArrowsForVerticalBar(ImDrawList* draw_list, ImVec2 pos, ImVec2
     ImGui::RenderArrowPointingAt(draw_list, ImVec2(pos.x + bar_w - half_sz.x,     pos.y), half_sz,                              ImGuiDir_Left,  IM_COL32(255,255,255,alpha8));
 }
 
+// Helper for ColorPicker4()
+// The wheel geometry only depends on the size and style, so it is built once into a template relative to the center, then translated.
+static void RenderColorPickerHueWheel(ImDrawList* draw_list, const ImVec2& wheel_center, float wheel_r_inner, float wheel_r_outer, const ImU32 col_hues[6 + 1])
+{
+    ImGuiContext& g = *GImGui;
+    const ImU32 col_alpha = col_hues[0] & IM_COL32_A_MASK;
+    const ImVec2 uv_white = draw_list->_Data->TexUvWhitePixel;
+    ImGuiColorPickerWheelCache* cache = NULL;
+    ImGuiColorPickerWheelCache* cache_oldest = NULL;
+    for (ImGuiColorPickerWheelCache& entry : g.ColorPickerWheelCache)
+    {
+        if (entry.RadiusInner == wheel_r_inner && entry.RadiusOuter == wheel_r_outer && entry.ColAlpha == col_alpha && entry.DrawListFlags == draw_list->Flags && entry.FringeScale == draw_list->_FringeScale
+            && entry.TexUvWhitePixel.x == uv_white.x && entry.TexUvWhitePixel.y == uv_white.y && entry.TexUvLines == draw_list->_Data->TexUvLines)
+        {
+            cache = &entry;
+            break;
+        }
+        if (cache_oldest == NULL || entry.LastFrameUsed < cache_oldest->LastFrameUsed)
+            cache_oldest = &entry;
+    }
+
+    if (cache != NULL)
+    {
+        cache->LastFrameUsed = g.FrameCount;
+        const int vtx_count = cache->VtxBuffer.Size;
+        const int idx_count = cache->IdxBuffer.Size;
+        draw_list->PrimReserve(idx_count, vtx_count);
+        ImDrawVert* vtx_write = draw_list->_VtxWritePtr;
+        for (const ImDrawVert& vtx : cache->VtxBuffer)
+        {
+            vtx_write->pos.x = vtx.pos.x + wheel_center.x;
+            vtx_write->pos.y = vtx.pos.y + wheel_center.y;
+            vtx_write->uv = vtx.uv;
+            vtx_write->col = vtx.col;
+            vtx_write++;
+        }
+        ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
+        const unsigned int idx_base = draw_list->_VtxCurrentIdx;
+        for (ImDrawIdx idx : cache->IdxBuffer)
+            *idx_write++ = (ImDrawIdx)(idx_base + idx);
+        draw_list->_VtxWritePtr = vtx_write;
+        draw_list->_IdxWritePtr = idx_write;
+        draw_list->_VtxCurrentIdx += vtx_count;
+        return;
+    }
+
+    if (g.ColorPickerWheelCache.Size < IMGUI_COLOR_PICKER_WHEEL_CACHE_MAX)
+    {
+        g.ColorPickerWheelCache.push_back(ImGuiColorPickerWheelCache());
+        cache = &g.ColorPickerWheelCache.back();
+    }
+    else
+    {
+        cache = cache_oldest;
+    }
+    cache->RadiusInner = wheel_r_inner;
+    cache->RadiusOuter = wheel_r_outer;
+    cache->ColAlpha = col_alpha;
+    cache->DrawListFlags = draw_list->Flags;
+    cache->FringeScale = draw_list->_FringeScale;
+    cache->TexUvWhitePixel = uv_white;
+    cache->TexUvLines = draw_list->_Data->TexUvLines;
+    cache->LastFrameUsed = g.FrameCount;
+    cache->VtxBuffer.resize(0);
+    cache->IdxBuffer.resize(0);
+
+    const ImU32 col_white = IM_COL32(255, 255, 255, 0) | col_alpha;
+    const float wheel_thickness = wheel_r_outer - wheel_r_inner;
+    const float aeps = 0.5f / wheel_r_outer; // Half a pixel arc length in radians (2pi cancels out).
+    const int segment_per_arc = ImMax(4, (int)wheel_r_outer / 12);
+    for (int n = 0; n < 6; n++)
+    {
+        const float a0 = (n)     /6.0f * 2.0f * IM_PI - aeps;
+        const float a1 = (n+1.0f)/6.0f * 2.0f * IM_PI + aeps;
+        const int vert_start_idx = draw_list->VtxBuffer.Size;
+        const int idx_start_idx = draw_list->IdxBuffer.Size;
+        draw_list->PathArcTo(wheel_center, (wheel_r_inner + wheel_r_outer)*0.5f, a0, a1, segment_per_arc);
+        draw_list->PathStroke(col_white, 0, wheel_thickness);
+        const int vert_end_idx = draw_list->VtxBuffer.Size;
+
+        // Paint colors over existing vertices
+        ImVec2 gradient_p0(wheel_center.x + ImCos(a0) * wheel_r_inner, wheel_center.y + ImSin(a0) * wheel_r_inner);
+        ImVec2 gradient_p1(wheel_center.x + ImCos(a1) * wheel_r_inner, wheel_center.y + ImSin(a1) * wheel_r_inner);
+        ImGui::ShadeVertsLinearColorGradientKeepAlpha(draw_list, vert_start_idx, vert_end_idx, gradient_p0, gradient_p1, col_hues[n], col_hues[n + 1]);
+
+        // Record the arc (PathStroke() reserves all of its vertices at once, so its indices start at _VtxCurrentIdx minus their count)
+        const int vtx_offset = cache->VtxBuffer.Size;
+        const unsigned int idx_base = draw_list->_VtxCurrentIdx - (unsigned int)(vert_end_idx - vert_start_idx);
+        for (int i = vert_start_idx; i < vert_end_idx; i++)
+        {
+            ImDrawVert vtx = draw_list->VtxBuffer[i];
+            vtx.pos.x -= wheel_center.x;
+            vtx.pos.y -= wheel_center.y;
+            cache->VtxBuffer.push_back(vtx);
+        }
+        for (int i = idx_start_idx; i < draw_list->IdxBuffer.Size; i++)
+            cache->IdxBuffer.push_back((ImDrawIdx)(draw_list->IdxBuffer[i] - idx_base + vtx_offset));
+    }
+}
+
 // Note: ColorPicker4() only accesses 3 floats if ImGuiColorEditFlags_NoAlpha flag is set.
 // (In C++ the 'float col[4]' notation for a function argument is equivalent to 'float* col', we only specify a size to facilitate understanding of the code.)
 // FIXME: we adjust the big color square height based on item width, which may cause a flickering feedback loop (if automatic height makes a vertical scrollbar appears, affecting automatic width..)
@@ -5881,22 +5984,7 @@ bool ImGui::ColorPicker4(ImStrv label, float col[4], ImGuiColorEditFlags flags,
     if (flags & ImGuiColorEditFlags_PickerHueWheel)
     {
         // Render Hue Wheel
-        const float aeps = 0.5f / wheel_r_outer; // Half a pixel arc length in radians (2pi cancels out).
-        const int segment_per_arc = ImMax(4, (int)wheel_r_outer / 12);
-        for (int n = 0; n < 6; n++)
-        {
-            const float a0 = (n)     /6.0f * 2.0f * IM_PI - aeps;
-            const float a1 = (n+1.0f)/6.0f * 2.0f * IM_PI + aeps;
-            const int vert_start_idx = draw_list->VtxBuffer.Size;
-            draw_list->PathArcTo(wheel_center, (wheel_r_inner + wheel_r_outer)*0.5f, a0, a1, segment_per_arc);
-            draw_list->PathStroke(col_white, 0, wheel_thickness);
-            const int vert_end_idx = draw_list->VtxBuffer.Size;
-
-            // Paint colors over existing vertices
-            ImVec2 gradient_p0(wheel_center.x + ImCos(a0) * wheel_r_inner, wheel_center.y + ImSin(a0) * wheel_r_inner);
-            ImVec2 gradient_p1(wheel_center.x + ImCos(a1) * wheel_r_inner, wheel_center.y + ImSin(a1) * wheel_r_inner);
-            ShadeVertsLinearColorGradientKeepAlpha(draw_list, vert_start_idx, vert_end_idx, gradient_p0, gradient_p1, col_hues[n], col_hues[n + 1]);
-        }
+        RenderColorPickerHueWheel(draw_list, wheel_center, wheel_r_inner, wheel_r_outer, col_hues);
 
         // Render Cursor + preview on Hue Wheel
         float cos_hue_angle = ImCos(H * 2.0f * IM_PI);
@@ -8076,21 +8164,32 @@ ImGuiSelectionExternalStorage::ImGuiSelectionExternalStorage()
 {
     UserData = NULL;
     AdapterSetItemSelected = NULL;
+    AdapterSetItemRangeSelected = NULL;
 }
 
 // Apply requests coming from BeginMultiSelect() and EndMultiSelect().
 // We also pull 'ms_io->ItemsCount' as passed for BeginMultiSelect() for consistency with ImGuiSelectionBasicStorage
 // This makes no assumption about underlying storage.
+// With AdapterSetItemRangeSelected() each request is a single call, leaving the application free to apply it with memset(), bit operations or a parallel loop.
 void ImGuiSelectionExternalStorage::ApplyRequests(ImGuiMultiSelectIO* ms_io)
 {
-    IM_ASSERT(AdapterSetItemSelected);
+    IM_ASSERT(AdapterSetItemSelected || AdapterSetItemRangeSelected);
     for (ImGuiSelectionRequest& req : ms_io->Requests)
     {
+        int idx_first = 0, idx_last = -1;
         if (req.Type == ImGuiSelectionRequestType_SetAll)
-            for (int idx = 0; idx < ms_io->ItemsCount; idx++)
-                AdapterSetItemSelected(this, idx, req.Selected);
-        if (req.Type == ImGuiSelectionRequestType_SetRange)
-            for (int idx = (int)req.RangeFirstItem; idx <= (int)req.RangeLastItem; idx++)
+            idx_last = ms_io->ItemsCount - 1;
+        else if (req.Type == ImGuiSelectionRequestType_SetRange)
+        {
+            idx_first = (int)req.RangeFirstItem;
+            idx_last = (int)req.RangeLastItem;
+        }
+        if (idx_first > idx_last)
+            continue;
+        if (AdapterSetItemRangeSelected)
+            AdapterSetItemRangeSelected(this, idx_first, idx_last, req.Selected);
+        else
+            for (int idx = idx_first; idx <= idx_last; idx++)
                 AdapterSetItemSelected(this, idx, req.Selected);
     }
 }